@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * Opt-in bump allocator for contract code.
+ *
+ * Include from exactly one translation unit of a contract. When the contract is built with
+ * CONTRACTS_USE_ARENA_ALLOCATOR, the global operator new and delete are replaced with a bump
+ * allocator over a static arena. Allocating advances a pointer and deallocating is a no-op, since
+ * the contract's linear memory is thrown away when the action ends. Requests that no longer fit in
+ * the arena fall back to malloc. Builds with CONTRACTS_MEMORY_STATS also replace operator new and
+ * delete, to count the live bytes, and keep malloc unless the arena is enabled as well. Without
+ * either flag this header defines nothing.
+ */
+#include <memory_stats.hpp>
+
+#if CONTRACTS_USE_ARENA_ALLOCATOR || CONTRACTS_MEMORY_STATS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifndef CONTRACTS_ARENA_SIZE
+#define CONTRACTS_ARENA_SIZE (64 * 1024)
+#endif
+
+namespace contract_arena {
+
+#if CONTRACTS_USE_ARENA_ALLOCATOR
+   constexpr size_t alignment = 16;
+
+   alignas(alignment) static char buffer[CONTRACTS_ARENA_SIZE];
+   static size_t                   used = 0;
+
+   inline bool owns( const void* p ) {
+      const auto addr = reinterpret_cast<uintptr_t>( p );
+      return addr >= reinterpret_cast<uintptr_t>( buffer ) && addr < reinterpret_cast<uintptr_t>( buffer + sizeof(buffer) );
+   }
+
+   inline void* allocate( size_t size ) {
+      if( size <= sizeof(buffer) - used ) {
+         const size_t aligned = size == 0 ? alignment : (size + alignment - 1) & ~(alignment - 1);
+         if( aligned <= sizeof(buffer) - used ) {
+            void* p = buffer + used;
+            used += aligned;
+            return p;
+         }
+      }
+      return malloc( size );
+   }
+
+   inline void deallocate( void* p ) {
+      if( p && !owns( p ) )
+         free( p );
+   }
+#else
+   inline void* allocate( size_t size ) {
+      return malloc( size );
+   }
+
+   inline void deallocate( void* p ) {
+      free( p );
+   }
+#endif
+
+#if CONTRACTS_MEMORY_STATS
+   inline void* new_block( size_t size ) {
+      return contract_memory::on_allocate( allocate( size + contract_memory::header_size ), size );
+   }
+
+   inline void delete_block( void* p ) {
+      if( p )
+         deallocate( contract_memory::on_deallocate( p ) );
+   }
+#else
+   inline void* new_block( size_t size ) { return allocate( size ); }
+   inline void delete_block( void* p )   { deallocate( p ); }
+#endif
+
+} /// namespace contract_arena
+
+void* operator new( size_t size ) { return contract_arena::new_block( size ); }
+void* operator new[]( size_t size ) { return contract_arena::new_block( size ); }
+void operator delete( void* p ) noexcept { contract_arena::delete_block( p ); }
+void operator delete[]( void* p ) noexcept { contract_arena::delete_block( p ); }
+void operator delete( void* p, size_t ) noexcept { contract_arena::delete_block( p ); }
+void operator delete[]( void* p, size_t ) noexcept { contract_arena::delete_block( p ); }
+
+#endif
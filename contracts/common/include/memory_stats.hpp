@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * Debug instrumentation of the heap use of a contract action.
+ *
+ * When a contract is built with CONTRACTS_MEMORY_STATS, every operator new and delete goes through
+ * the counters below (see arena_allocator.hpp), and CONTRACT_MEMORY_REPORT() prints one line to the
+ * action console:
+ *
+ *    memstats allocations=<count> peak_bytes=<most bytes allocated and not yet deleted> pages=<linear memory pages>
+ *
+ * Stats builds keep the requested size in a header in front of every block, so deleting a block
+ * lowers the live bytes. The page count is the size linear memory grew to during the action, which
+ * also covers malloc calls the counters do not see and the space the headers and a bump arena do
+ * not give back. Contracts report from the destructor of their contract class, so the line is the
+ * last output of the action. Without the flag the macro expands to nothing.
+ */
+#if CONTRACTS_MEMORY_STATS
+
+#include <eosio/print.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace contract_memory {
+
+   /// bytes in front of every block, a multiple of the allocator alignment
+   constexpr size_t header_size = 16;
+
+   inline uint64_t allocations = 0;
+   inline uint64_t live_bytes  = 0;
+   inline uint64_t peak_bytes  = 0;
+
+   /// Counts a request of `size` bytes served by `block`, which has room for the header, and returns the memory for the caller
+   inline void* on_allocate( void* block, size_t size ) {
+      ++allocations;
+      live_bytes += size;
+      if( live_bytes > peak_bytes )
+         peak_bytes = live_bytes;
+      *static_cast<size_t*>( block ) = size;
+      return static_cast<char*>( block ) + header_size;
+   }
+
+   /// Releases the count of memory returned by `on_allocate` and returns its block
+   inline void* on_deallocate( void* p ) {
+      void* block = static_cast<char*>( p ) - header_size;
+      live_bytes -= *static_cast<size_t*>( block );
+      return block;
+   }
+
+   inline void report() {
+      eosio::print( "memstats allocations=", allocations, " peak_bytes=", peak_bytes,
+                    " pages=", uint64_t( __builtin_wasm_memory_size(0) ), "\n" );
+   }
+
+} /// namespace contract_memory
+
+#define CONTRACT_MEMORY_REPORT()       contract_memory::report()
+
+#else
+
+#define CONTRACT_MEMORY_REPORT()
+
+#endif
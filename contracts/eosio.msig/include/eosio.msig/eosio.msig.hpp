@@ -3,8 +3,11 @@
 #include <eosio/binary_extension.hpp>
 #include <eosio/eosio.hpp>
 #include <eosio/ignore.hpp>
+#include <eosio/singleton.hpp>
 #include <eosio/transaction.hpp>
 
+#include <optional>
+
 namespace eosio {
    /**
     * @defgroup eosiomsig eosio.msig
@@ -16,6 +19,21 @@ namespace eosio {
       public:
          using contract::contract;
 
+#if CONTRACTS_MEMORY_STATS
+         /// reports the heap use of the action, see memory_stats.hpp
+         ~multisig();
+#endif
+
+         /**
+          * Reference to a proposal used by the batched approval actions, optionally
+          * pinned to the checksum of the proposed transaction.
+          */
+         struct proposal_ref {
+            name                               proposer;
+            name                               proposal_name;
+            std::optional<eosio::checksum256>  proposal_hash;
+         };
+
          /**
           * Create proposal
           *
@@ -25,9 +43,9 @@ namespace eosio {
           * permission levels then `trx` transaction can we executed by this proposal.
           * The `proposer` account is authorized and the `trx` transaction is verified if it was
           * authorized by the provided keys and permissions, and if the proposal name doesn’t
-          * already exist; if all validations pass the `proposal_name` and `trx` trasanction are
-          * saved in the proposals table and the `requested` permission levels to the
-          * approvals table (for the `proposer` context).
+          * already exist; if all validations pass the `proposal_name`, the `trx` transaction and its
+          * checksum are saved in the proposals table and the `requested` permission levels
+          * are saved to the approvals table (for the `proposer` context).
           * Storage changes are billed to `proposer`.
           *
           * @param proposer - The account proposing a transaction
@@ -44,9 +62,9 @@ namespace eosio {
           * @details Approves an existing proposal
           * Allows an account, the owner of `level` permission, to approve a proposal `proposal_name`
           * proposed by `proposer`. If the proposal's requested approval list contains the `level`
-          * permission then the `level` permission is moved from internal `requested_approvals` list to
-          * internal `provided_approvals` list of the proposal, thus persisting the approval for
-          * the `proposal_name` proposal.
+          * permission then the `level` permission is marked as approved in the internal `approvals`
+          * list of the proposal (or moved from `requested_approvals` to `provided_approvals` for
+          * proposals created before version 2), thus persisting the approval for the `proposal_name` proposal.
           * Storage changes are billed to `proposer`.
           *
           * @param proposer - The account proposing a transaction
@@ -62,8 +80,8 @@ namespace eosio {
           *
           * @details Revokes an existing proposal
           * This action is the reverse of the `approve` action: if all validations pass
-          * the `level` permission is erased from internal `provided_approvals` and added to the internal
-          * `requested_approvals` list, and thus un-approve or revoke the proposal.
+          * the `level` permission is marked as not approved in the internal `approvals` list (or moved back
+          * to `requested_approvals` for proposals created before version 2), and thus un-approve or revoke the proposal.
           *
           * @param proposer - The account proposing a transaction
           * @param proposal_name - The name of the proposal (should be an existing proposal)
@@ -71,6 +89,33 @@ namespace eosio {
           */
          [[eosio::action]]
          void unapprove( name proposer, name proposal_name, permission_level level );
+         /**
+          * Approve many proposals
+          *
+          * @details Approves several existing proposals with one permission level.
+          * Behaves as one `approve` per entry of `proposals`, but the authorization of
+          * `level` is only checked once. If an entry carries a `proposal_hash`, the
+          * proposed transaction must match it.
+          * Storage changes are billed to the respective proposers.
+          *
+          * @param level - Permission level approving the transactions
+          * @param proposals - Proposals to approve
+          */
+         [[eosio::action]]
+         void approvemany( permission_level level, const std::vector<proposal_ref>& proposals );
+         /**
+          * Revoke many proposals
+          *
+          * @details Revokes the approval of `level` from several existing proposals.
+          * Behaves as one `unapprove` per entry of `proposals`, but the authorization of
+          * `level` is only checked once. If an entry carries a `proposal_hash`, the
+          * proposed transaction must match it.
+          *
+          * @param level - Permission level revoking approval for the proposals
+          * @param proposals - Proposals to revoke approval from
+          */
+         [[eosio::action]]
+         void unapprovemany( permission_level level, const std::vector<proposal_ref>& proposals );
          /**
           * Cancel proposal
           *
@@ -107,34 +152,117 @@ namespace eosio {
           */
          [[eosio::action]]
          void exec( name proposer, name proposal_name, name executer );
+         /**
+          * Execute proposal inline
+          *
+          * @details Same as `exec`, but the actions of the proposed transaction are dispatched as
+          * inline actions of the current transaction instead of a deferred transaction. Their
+          * results show up in the trace of this action and nothing is added to the deferred queue.
+          * The proposed transaction must not have a delay and must not contain context-free actions.
+          *
+          * @param proposer - The account proposing a transaction
+          * @param proposal_name - The name of the proposal (should be an existing proposal)
+          * @param executer - The account executing the transaction
+          */
+         [[eosio::action]]
+         void execinline( name proposer, name proposal_name, name executer );
          /**
           * Invalidate proposal
           *
           * @details Allows an `account` to invalidate itself, that is, its name is added to
-          * the invalidations table and this table will be cross referenced when exec is performed.
+          * the invalidations table and this table will be cross referenced when exec is performed
+          * for approvals provided before the latest invalidation of any account.
           *
           * @param account - The account invalidating the transaction
           */
          [[eosio::action]]
          void invalidate( name account );
+         /**
+          * Migrate legacy approvals
+          *
+          * @details Converts up to `max_rows` rows of the legacy `approvals` table in the `proposer`
+          * scope into `approvals2` rows. Provided approvals keep the legacy semantics: any
+          * invalidation of the approving account voids them. Migrated rows are erased from the
+          * legacy table, so repeated calls continue where the previous one stopped.
+          * Storage changes are billed to `proposer`.
+          *
+          * @param proposer - The account whose legacy approvals are migrated
+          * @param max_rows - Maximum number of rows to migrate
+          *
+          * @pre Requires authorization of the contract account.
+          */
+         [[eosio::action]]
+         void migrate( name proposer, uint16_t max_rows );
+         /**
+          * Set migrated flag
+          *
+          * @details Once every legacy `approvals` row has been migrated, setting `migrated` stops
+          * `approve`, `unapprove`, `cancel` and `exec` from probing the legacy table when a
+          * proposal is not found in `approvals2`.
+          *
+          * @param migrated - Whether the legacy approvals table is known to be empty
+          *
+          * @pre Requires authorization of the contract account.
+          */
+         [[eosio::action]]
+         void setmigrated( bool migrated );
+         /**
+          * Sweep expired proposals
+          *
+          * @details Erases up to `max` proposals whose transaction has expired, oldest expiration
+          * first, together with their approvals. Anyone may call this action; the RAM of the
+          * erased rows is returned to the respective proposers.
+          *
+          * Only proposals created since expirations are tracked can be swept, older ones
+          * still have to be cancelled.
+          *
+          * @param max - Maximum number of proposals to erase
+          */
+         [[eosio::action]]
+         void sweep( uint16_t max );
 
          using propose_action = eosio::action_wrapper<"propose"_n, &multisig::propose>;
          using approve_action = eosio::action_wrapper<"approve"_n, &multisig::approve>;
          using unapprove_action = eosio::action_wrapper<"unapprove"_n, &multisig::unapprove>;
+         using approvemany_action = eosio::action_wrapper<"approvemany"_n, &multisig::approvemany>;
+         using unapprovemany_action = eosio::action_wrapper<"unapprovemany"_n, &multisig::unapprovemany>;
          using cancel_action = eosio::action_wrapper<"cancel"_n, &multisig::cancel>;
          using exec_action = eosio::action_wrapper<"exec"_n, &multisig::exec>;
+         using execinline_action = eosio::action_wrapper<"execinline"_n, &multisig::execinline>;
          using invalidate_action = eosio::action_wrapper<"invalidate"_n, &multisig::invalidate>;
+         using migrate_action = eosio::action_wrapper<"migrate"_n, &multisig::migrate>;
+         using setmigrated_action = eosio::action_wrapper<"setmigrated"_n, &multisig::setmigrated>;
+         using sweep_action = eosio::action_wrapper<"sweep"_n, &multisig::sweep>;
 
       private:
          struct [[eosio::table]] proposal {
             name                            proposal_name;
             std::vector<char>               packed_transaction;
+            //checksum of `packed_transaction`, compared by approvals pinned to a hash; absent in
+            //proposals made before it was stored
+            eosio::binary_extension<eosio::checksum256> trx_hash;
 
             uint64_t primary_key()const { return proposal_name.value; }
          };
 
          typedef eosio::multi_index< "proposal"_n, proposal > proposals;
 
+         struct [[eosio::table]] proposal_expiry {
+            uint64_t                        id;
+            name                            proposer;
+            name                            proposal_name;
+            time_point_sec                  expiration;
+
+            uint64_t  primary_key()const   { return id; }
+            uint64_t  by_expiration()const { return expiration.utc_seconds; }
+            uint128_t by_proposal()const   { return (uint128_t(proposer.value) << 64) | proposal_name.value; }
+         };
+
+         typedef eosio::multi_index< "expiry"_n, proposal_expiry,
+                                     indexed_by<"byexpiration"_n, const_mem_fun<proposal_expiry, uint64_t, &proposal_expiry::by_expiration>>,
+                                     indexed_by<"byproposal"_n, const_mem_fun<proposal_expiry, uint128_t, &proposal_expiry::by_proposal>>
+                                   > proposal_expiries;
+
          struct [[eosio::table]] old_approvals_info {
             name                            proposal_name;
             std::vector<permission_level>   requested_approvals;
@@ -149,14 +277,23 @@ namespace eosio {
             time_point       time;
          };
 
+         struct approval_entry {
+            permission_level level;
+            time_point       time;
+            bool             approved = false;
+         };
+
          struct [[eosio::table]] approvals_info {
-            uint8_t                 version = 1;
+            uint8_t                 version = 2;
             name                    proposal_name;
             //requested approval doesn't need to cointain time, but we want requested approval
             //to be of exact the same size ad provided approval, in this case approve/unapprove
             //doesn't change serialized data size. So, we use the same type.
             std::vector<approval>   requested_approvals;
             std::vector<approval>   provided_approvals;
+            //version 2 leaves both vectors above empty and keeps every requested level here,
+            //sorted by permission level, so approvals are found by binary search and flipped in place.
+            eosio::binary_extension<std::vector<approval_entry>> approvals;
 
             uint64_t primary_key()const { return proposal_name.value; }
          };
@@ -170,6 +307,24 @@ namespace eosio {
          };
 
          typedef eosio::multi_index< "invals"_n, invalidation > invalidations;
+
+         struct [[eosio::table("global")]] msig_global_state {
+            bool         legacy_approvals_migrated = false;
+            //latest invalidation of any account, or the first exec when none was tracked yet;
+            //approvals recorded later need no invals lookup
+            eosio::binary_extension<time_point> last_invalidation_time;
+         };
+
+         typedef eosio::singleton< "global"_n, msig_global_state > global_state_singleton;
+
+         bool legacy_approvals_migrated();
+         void execute( name proposer, name proposal_name, name executer, bool dispatch_inline );
+         bool erase_approvals( name proposer, name proposal_name );
+         void erase_expiry( name proposer, name proposal_name );
+         void add_approval( name proposer, name proposal_name, const permission_level& level,
+                            const eosio::checksum256* proposal_hash );
+         void remove_approval( name proposer, name proposal_name, const permission_level& level );
+         void check_proposal_hash( name proposer, name proposal_name, const eosio::checksum256& proposal_hash );
    };
    /** @}*/ // end of @defgroup eosiomsig eosio.msig
 } /// namespace eosio
@@ -4,8 +4,27 @@
 #include <eosio/permission.hpp>
 #include <eosio/crypto.hpp>
 
+#include <arena_allocator.hpp>
+
 namespace eosio {
 
+namespace {
+
+   template<typename Entries>
+   auto find_approval( Entries& entries, const permission_level& level ) {
+      auto itr = std::lower_bound( entries.begin(), entries.end(), level,
+                                   []( const auto& e, const permission_level& l ) { return e.level < l; } );
+      return ( itr != entries.end() && itr->level == level ) ? itr : entries.end();
+   }
+
+} /// anonymous namespace
+
+#if CONTRACTS_MEMORY_STATS
+multisig::~multisig() {
+   CONTRACT_MEMORY_REPORT();
+}
+#endif
+
 void multisig::propose( ignore<name> proposer,
                         ignore<name> proposal_name,
                         ignore<std::vector<permission_level>> requested,
@@ -44,15 +63,30 @@ void multisig::propose( ignore<name> proposer,
    proptable.emplace( _proposer, [&]( auto& prop ) {
       prop.proposal_name       = _proposal_name;
       prop.packed_transaction  = pkd_trans;
+      prop.trx_hash.emplace( sha256( trx_pos, size ) );
    });
 
+   std::sort( _requested.begin(), _requested.end() );
+   _requested.erase( std::unique( _requested.begin(), _requested.end() ), _requested.end() );
+
+   std::vector<approval_entry> entries;
+   entries.reserve( _requested.size() );
+   for ( auto& level : _requested ) {
+      entries.push_back( approval_entry{ level, time_point{ microseconds{0} }, false } );
+   }
+
    approvals apptable( get_self(), _proposer.value );
    apptable.emplace( _proposer, [&]( auto& a ) {
       a.proposal_name       = _proposal_name;
-      a.requested_approvals.reserve( _requested.size() );
-      for ( auto& level : _requested ) {
-         a.requested_approvals.push_back( approval{ level, time_point{ microseconds{0} } } );
-      }
+      a.approvals.emplace( std::move(entries) );
+   });
+
+   proposal_expiries exptable( get_self(), get_self().value );
+   exptable.emplace( _proposer, [&]( auto& e ) {
+      e.id            = exptable.available_primary_key();
+      e.proposer      = _proposer;
+      e.proposal_name = _proposal_name;
+      e.expiration    = _trx_header.expiration;
    });
 }
 
@@ -60,16 +94,66 @@ void multisig::approve( name proposer, name proposal_name, permission_level leve
                         const eosio::binary_extension<eosio::checksum256>& proposal_hash )
 {
    require_auth( level );
+   add_approval( proposer, proposal_name, level, proposal_hash ? &*proposal_hash : nullptr );
+}
+
+void multisig::unapprove( name proposer, name proposal_name, permission_level level ) {
+   require_auth( level );
+   remove_approval( proposer, proposal_name, level );
+}
+
+void multisig::approvemany( permission_level level, const std::vector<proposal_ref>& proposals ) {
+   require_auth( level );
+   check( proposals.size() > 0, "no proposals to approve" );
+
+   for ( auto& p : proposals ) {
+      add_approval( p.proposer, p.proposal_name, level, p.proposal_hash ? &*p.proposal_hash : nullptr );
+   }
+}
+
+void multisig::unapprovemany( permission_level level, const std::vector<proposal_ref>& proposals ) {
+   require_auth( level );
+   check( proposals.size() > 0, "no proposals to unapprove" );
 
+   for ( auto& p : proposals ) {
+      if( p.proposal_hash ) {
+         check_proposal_hash( p.proposer, p.proposal_name, *p.proposal_hash );
+      }
+      remove_approval( p.proposer, p.proposal_name, level );
+   }
+}
+
+void multisig::check_proposal_hash( name proposer, name proposal_name, const eosio::checksum256& proposal_hash ) {
+   proposals proptable( get_self(), proposer.value );
+   auto& prop = proptable.get( proposal_name.value, "proposal not found" );
+   if ( prop.trx_hash && *prop.trx_hash == proposal_hash ) {
+      return;
+   }
+   // proposals without a stored checksum and mismatches hash the transaction, which fails with the crypto error
+   assert_sha256( prop.packed_transaction.data(), prop.packed_transaction.size(), proposal_hash );
+}
+
+void multisig::add_approval( name proposer, name proposal_name, const permission_level& level,
+                             const eosio::checksum256* proposal_hash )
+{
    if( proposal_hash ) {
-      proposals proptable( get_self(), proposer.value );
-      auto& prop = proptable.get( proposal_name.value, "proposal not found" );
-      assert_sha256( prop.packed_transaction.data(), prop.packed_transaction.size(), *proposal_hash );
+      check_proposal_hash( proposer, proposal_name, *proposal_hash );
    }
 
    approvals apptable( get_self(), proposer.value );
    auto apps_it = apptable.find( proposal_name.value );
-   if ( apps_it != apptable.end() ) {
+   if ( apps_it != apptable.end() && apps_it->version >= 2 ) {
+      const auto& entries = apps_it->approvals.value();
+      auto itr = find_approval( entries, level );
+      check( itr != entries.end() && !itr->approved, "approval is not on the list of requested approvals" );
+      auto idx = itr - entries.begin();
+
+      apptable.modify( apps_it, proposer, [&]( auto& a ) {
+            auto& e = a.approvals.value()[idx];
+            e.approved = true;
+            e.time     = current_time_point();
+         });
+   } else if ( apps_it != apptable.end() ) {
       auto itr = std::find_if( apps_it->requested_approvals.begin(), apps_it->requested_approvals.end(), [&](const approval& a) { return a.level == level; } );
       check( itr != apps_it->requested_approvals.end(), "approval is not on the list of requested approvals" );
 
@@ -78,6 +162,7 @@ void multisig::approve( name proposer, name proposal_name, permission_level leve
             a.requested_approvals.erase( itr );
          });
    } else {
+      check( !legacy_approvals_migrated(), "proposal not found" );
       old_approvals old_apptable( get_self(), proposer.value );
       auto& apps = old_apptable.get( proposal_name.value, "proposal not found" );
 
@@ -91,12 +176,21 @@ void multisig::approve( name proposer, name proposal_name, permission_level leve
    }
 }
 
-void multisig::unapprove( name proposer, name proposal_name, permission_level level ) {
-   require_auth( level );
-
+void multisig::remove_approval( name proposer, name proposal_name, const permission_level& level ) {
    approvals apptable( get_self(), proposer.value );
    auto apps_it = apptable.find( proposal_name.value );
-   if ( apps_it != apptable.end() ) {
+   if ( apps_it != apptable.end() && apps_it->version >= 2 ) {
+      const auto& entries = apps_it->approvals.value();
+      auto itr = find_approval( entries, level );
+      check( itr != entries.end() && itr->approved, "no approval previously granted" );
+      auto idx = itr - entries.begin();
+
+      apptable.modify( apps_it, proposer, [&]( auto& a ) {
+            auto& e = a.approvals.value()[idx];
+            e.approved = false;
+            e.time     = current_time_point();
+         });
+   } else if ( apps_it != apptable.end() ) {
       auto itr = std::find_if( apps_it->provided_approvals.begin(), apps_it->provided_approvals.end(), [&](const approval& a) { return a.level == level; } );
       check( itr != apps_it->provided_approvals.end(), "no approval previously granted" );
       apptable.modify( apps_it, proposer, [&]( auto& a ) {
@@ -104,6 +198,7 @@ void multisig::unapprove( name proposer, name proposal_name, permission_level le
             a.provided_approvals.erase( itr );
          });
    } else {
+      check( !legacy_approvals_migrated(), "proposal not found" );
       old_approvals old_apptable( get_self(), proposer.value );
       auto& apps = old_apptable.get( proposal_name.value, "proposal not found" );
       auto itr = std::find( apps.provided_approvals.begin(), apps.provided_approvals.end(), level );
@@ -126,26 +221,26 @@ void multisig::cancel( name proposer, name proposal_name, name canceler ) {
    }
    proptable.erase(prop);
 
-   //remove from new table
-   approvals apptable( get_self(), proposer.value );
-   auto apps_it = apptable.find( proposal_name.value );
-   if ( apps_it != apptable.end() ) {
-      apptable.erase(apps_it);
-   } else {
-      old_approvals old_apptable( get_self(), proposer.value );
-      auto apps_it = old_apptable.find( proposal_name.value );
-      check( apps_it != old_apptable.end(), "proposal not found" );
-      old_apptable.erase(apps_it);
-   }
+   check( erase_approvals( proposer, proposal_name ), "proposal not found" );
+   erase_expiry( proposer, proposal_name );
 }
 
 void multisig::exec( name proposer, name proposal_name, name executer ) {
+   execute( proposer, proposal_name, executer, false );
+}
+
+void multisig::execinline( name proposer, name proposal_name, name executer ) {
+   execute( proposer, proposal_name, executer, true );
+}
+
+void multisig::execute( name proposer, name proposal_name, name executer, bool dispatch_inline ) {
    require_auth( executer );
 
    proposals proptable( get_self(), proposer.value );
    auto& prop = proptable.get( proposal_name.value, "proposal not found" );
+   const auto& packed_transaction = prop.packed_transaction;
    transaction_header trx_header;
-   datastream<const char*> ds( prop.packed_transaction.data(), prop.packed_transaction.size() );
+   datastream<const char*> ds( packed_transaction.data(), packed_transaction.size() );
    ds >> trx_header;
    check( trx_header.expiration >= eosio::time_point_sec(current_time_point()), "transaction expired" );
 
@@ -153,16 +248,41 @@ void multisig::exec( name proposer, name proposal_name, name executer ) {
    auto apps_it = apptable.find( proposal_name.value );
    std::vector<permission_level> approvals;
    invalidations inv_table( get_self(), get_self().value );
-   if ( apps_it != apptable.end() ) {
+
+   // invals rows written before the latest invalidation was tracked are all older than now,
+   // so the first read seeds it with the current time and later approvals skip the lookup
+   global_state_singleton global( get_self(), get_self().value );
+   auto gstate = global.get_or_default();
+   if ( !gstate.last_invalidation_time ) {
+      gstate.last_invalidation_time.emplace( current_time_point() );
+      global.set( gstate, get_self() );
+   }
+   auto is_valid = [&]( const permission_level& level, const time_point& approval_time ) {
+      if ( *gstate.last_invalidation_time < approval_time ) {
+         return true;
+      }
+      auto it = inv_table.find( level.actor.value );
+      return it == inv_table.end() || it->last_invalidation_time < approval_time;
+   };
+
+   if ( apps_it != apptable.end() && apps_it->version >= 2 ) {
+      approvals.reserve( apps_it->approvals.value().size() );
+      for ( auto& e : apps_it->approvals.value() ) {
+         if ( e.approved && is_valid( e.level, e.time ) ) {
+            approvals.push_back(e.level);
+         }
+      }
+      apptable.erase(apps_it);
+   } else if ( apps_it != apptable.end() ) {
       approvals.reserve( apps_it->provided_approvals.size() );
       for ( auto& p : apps_it->provided_approvals ) {
-         auto it = inv_table.find( p.level.actor.value );
-         if ( it == inv_table.end() || it->last_invalidation_time < p.time ) {
+         if ( is_valid( p.level, p.time ) ) {
             approvals.push_back(p.level);
          }
       }
       apptable.erase(apps_it);
    } else {
+      check( !legacy_approvals_migrated(), "proposal not found" );
       old_approvals old_apptable( get_self(), proposer.value );
       auto& apps = old_apptable.get( proposal_name.value, "proposal not found" );
       for ( auto& level : apps.provided_approvals ) {
@@ -176,16 +296,27 @@ void multisig::exec( name proposer, name proposal_name, name executer ) {
    auto packed_provided_approvals = pack(approvals);
    // TODO: Remove internal_use_do_not_use namespace after minimum eosio.cdt dependency becomes 1.7.x
    auto res =  internal_use_do_not_use::check_transaction_authorization(
-                  prop.packed_transaction.data(), prop.packed_transaction.size(),
+                  packed_transaction.data(), packed_transaction.size(),
                   (const char*)0, 0,
                   packed_provided_approvals.data(), packed_provided_approvals.size()
                );
    check( res > 0, "transaction authorization failed" );
 
-   send_deferred( (uint128_t(proposer.value) << 64) | proposal_name.value, executer,
-                  prop.packed_transaction.data(), prop.packed_transaction.size() );
+   if ( dispatch_inline ) {
+      // authorization of the actions was checked above, eosio.msig is privileged
+      check( trx_header.delay_sec.value == 0, "inline execution requires a transaction without delay" );
+      auto trx = unpack<transaction>( packed_transaction );
+      check( trx.context_free_actions.empty(), "inline execution does not support context-free actions" );
+      for ( const auto& act : trx.actions ) {
+         act.send();
+      }
+   } else {
+      send_deferred( (uint128_t(proposer.value) << 64) | proposal_name.value, executer,
+                     packed_transaction.data(), packed_transaction.size() );
+   }
 
    proptable.erase(prop);
+   erase_expiry( proposer, proposal_name );
 }
 
 void multisig::invalidate( name account ) {
@@ -202,6 +333,103 @@ void multisig::invalidate( name account ) {
             i.last_invalidation_time = current_time_point();
          });
    }
+
+   global_state_singleton global( get_self(), get_self().value );
+   auto state = global.get_or_default();
+   state.last_invalidation_time.emplace( current_time_point() );
+   global.set( state, get_self() );
+}
+
+void multisig::migrate( name proposer, uint16_t max_rows ) {
+   require_auth( get_self() );
+   check( max_rows > 0, "max_rows must be positive" );
+
+   old_approvals old_apptable( get_self(), proposer.value );
+   approvals apptable( get_self(), proposer.value );
+   for ( auto it = old_apptable.begin(); it != old_apptable.end() && max_rows > 0; --max_rows ) {
+      // legacy approvals carry no time, so any invalidation of the approver voids them
+      std::vector<approval_entry> entries;
+      entries.reserve( it->provided_approvals.size() + it->requested_approvals.size() );
+      for ( auto& level : it->provided_approvals ) {
+         entries.push_back( approval_entry{ level, time_point{ microseconds{0} }, true } );
+      }
+      for ( auto& level : it->requested_approvals ) {
+         entries.push_back( approval_entry{ level, time_point{ microseconds{0} }, false } );
+      }
+      // stable sort keeps a provided entry ahead of a requested duplicate of the same level
+      std::stable_sort( entries.begin(), entries.end(),
+                        []( const approval_entry& a, const approval_entry& b ) { return a.level < b.level; } );
+      entries.erase( std::unique( entries.begin(), entries.end(),
+                                  []( const approval_entry& a, const approval_entry& b ) { return a.level == b.level; } ),
+                     entries.end() );
+
+      apptable.emplace( proposer, [&]( auto& a ) {
+         a.proposal_name = it->proposal_name;
+         a.approvals.emplace( std::move(entries) );
+      });
+      it = old_apptable.erase( it );
+   }
+}
+
+void multisig::setmigrated( bool migrated ) {
+   require_auth( get_self() );
+   global_state_singleton global( get_self(), get_self().value );
+   auto state = global.get_or_default();
+   state.legacy_approvals_migrated = migrated;
+   global.set( state, get_self() );
+}
+
+void multisig::sweep( uint16_t max ) {
+   check( max > 0, "max must be positive" );
+   const auto now = eosio::time_point_sec(current_time_point());
+
+   proposal_expiries exptable( get_self(), get_self().value );
+   auto idx = exptable.get_index<"byexpiration"_n>();
+   uint16_t swept = 0;
+   for ( auto it = idx.begin(); it != idx.end() && it->expiration < now && swept < max; ++swept ) {
+      proposals proptable( get_self(), it->proposer.value );
+      auto prop_it = proptable.find( it->proposal_name.value );
+      if ( prop_it != proptable.end() ) {
+         proptable.erase( prop_it );
+      }
+      erase_approvals( it->proposer, it->proposal_name );
+      it = idx.erase( it );
+   }
+   check( swept > 0, "no expired proposals to sweep" );
+}
+
+bool multisig::erase_approvals( name proposer, name proposal_name ) {
+   approvals apptable( get_self(), proposer.value );
+   auto apps_it = apptable.find( proposal_name.value );
+   if ( apps_it != apptable.end() ) {
+      apptable.erase(apps_it);
+      return true;
+   }
+   if ( legacy_approvals_migrated() ) {
+      return false;
+   }
+   old_approvals old_apptable( get_self(), proposer.value );
+   auto old_apps_it = old_apptable.find( proposal_name.value );
+   if ( old_apps_it == old_apptable.end() ) {
+      return false;
+   }
+   old_apptable.erase(old_apps_it);
+   return true;
+}
+
+void multisig::erase_expiry( name proposer, name proposal_name ) {
+   proposal_expiries exptable( get_self(), get_self().value );
+   auto idx = exptable.get_index<"byproposal"_n>();
+   auto it = idx.find( (uint128_t(proposer.value) << 64) | proposal_name.value );
+   // proposals created before expirations were tracked have no entry
+   if ( it != idx.end() ) {
+      idx.erase( it );
+   }
+}
+
+bool multisig::legacy_approvals_migrated() {
+   global_state_singleton global( get_self(), get_self().value );
+   return global.exists() && global.get().legacy_approvals_migrated;
 }
 
 } /// namespace eosio
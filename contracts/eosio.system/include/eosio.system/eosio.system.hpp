@@ -1,12 +1,17 @@
 #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/privileged.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
 #include <eosio/time.hpp>
 
 #include <eosio.system/exchange_state.hpp>
+#include <eosio.system/fixed_layout.hpp>
+#include <eosio.system/inflation.hpp>
+#include <eosio.system/lazy_table.hpp>
+#include <eosio.system/profile.hpp>
 #include <eosio.system/worbli.hpp>
 #include <eosio.system/native.hpp>
 
@@ -24,6 +29,20 @@
 // be set to 0.
 #define CHANNEL_RAM_AND_NAMEBID_FEES_TO_REX 1
 
+// SYSTEM_ENABLE_REX macro determines whether the resource exchange (REX) tables, actions and
+// rex.cpp are compiled into the contract. It is normally set by the CMake option of the same name.
+#ifndef SYSTEM_ENABLE_REX
+#define SYSTEM_ENABLE_REX 1
+#endif
+
+// SYSTEM_ENABLE_RAMMARKET macro determines whether `setram` keeps the bancor reserves of the
+// `rammarket` table in step with max_ram_size. RAM is sold at a flat price, so the table is
+// otherwise only used to store the core symbol. It is normally set by the CMake option of the
+// same name.
+#ifndef SYSTEM_ENABLE_RAMMARKET
+#define SYSTEM_ENABLE_RAMMARKET 1
+#endif
+
 namespace eosiosystem {
 
    using namespace worblisystem;
@@ -70,7 +89,8 @@ namespace eosiosystem {
    static constexpr int64_t  min_activated_stake   = 150'000'000'0000;
    static constexpr int64_t  ram_gift_bytes        = 0;
    static constexpr int64_t  min_pervote_daily_pay = 100'0000;
-   static constexpr double   continuous_rate       = 0.05827323; // 6% annual rate
+   static constexpr uint32_t default_inflation_numerator   = 5'827'323;   // 0.05827323 continuous, 6% annual rate
+   static constexpr uint32_t default_inflation_denominator = 100'000'000; // unless overridden by setinflation
    static constexpr int64_t  inflation_pay_factor  = 5;                // 20% of the inflation
    static constexpr int64_t  votepay_factor        = 4;                // 25% of the producer pay
    static constexpr uint32_t refund_delay_sec      = 3 * seconds_per_day;
@@ -142,10 +162,15 @@ namespace eosiosystem {
 **/
    /**
     * Defines new global state parameters.
+    *
+    * @details Only loaded by actions that need the parameter block, today `setparams`. The fields also
+    * kept in `eosio_global_hot_state` (`max_ram_size`, `total_ram_bytes_reserved`, `total_ram_stake`,
+    * `last_producer_schedule_update`, `last_inflation_distribution`, `last_producer_schedule_size`,
+    * `is_producer_schedule_active` and `network_usage_level`) are superseded by it. They are only
+    * mirrored here when this row is written, so in between they are a stale snapshot; off-chain
+    * readers must take them from the `globalhot` table.
     */
    struct [[eosio::table("global"), eosio::contract("eosio.system")]] eosio_global_state : eosio::blockchain_parameters {
-      uint64_t free_ram()const { return max_ram_size - total_ram_bytes_reserved; }
-
       uint64_t             max_ram_size = 64ll*1024 * 1024 * 1024;
       uint64_t             total_ram_bytes_reserved = 0;
       int64_t              total_ram_stake = 0;
@@ -172,6 +197,55 @@ namespace eosiosystem {
                                 (is_producer_schedule_active)(network_usage_level) )
    };
 
+   /**
+    * Global state fields read or written by most actions, kept in their own small singleton so the
+    * parameter block of `eosio_global_state` does not have to be deserialized and rewritten every time.
+    */
+   struct [[eosio::table("globalhot"), eosio::contract("eosio.system")]] eosio_global_hot_state {
+      uint64_t free_ram()const { return max_ram_size - total_ram_bytes_reserved; }
+
+      uint64_t                  max_ram_size = 64ll*1024 * 1024 * 1024;
+      uint64_t                  total_ram_bytes_reserved = 0;
+      int64_t                   total_ram_stake = 0;
+      block_timestamp           last_producer_schedule_update;
+      time_point                last_inflation_distribution;
+      uint16_t                  last_producer_schedule_size = 0;
+      bool                      is_producer_schedule_active = false;
+      uint8_t                   network_usage_level = 0;
+      std::optional<uint32_t>   produced_schedule_version; ///< active schedule version `produced_blocks` refers to
+      uint64_t                  produced_blocks = 0; ///< one bit per schedule position that produced since the last roll-up
+
+      /// seeds the hot state from a global row written before the split
+      static eosio_global_hot_state from( const eosio_global_state& g ) {
+         eosio_global_hot_state h;
+         h.max_ram_size                  = g.max_ram_size;
+         h.total_ram_bytes_reserved      = g.total_ram_bytes_reserved;
+         h.total_ram_stake               = g.total_ram_stake;
+         h.last_producer_schedule_update = g.last_producer_schedule_update;
+         h.last_inflation_distribution   = g.last_inflation_distribution;
+         h.last_producer_schedule_size   = g.last_producer_schedule_size;
+         h.is_producer_schedule_active   = g.is_producer_schedule_active;
+         h.network_usage_level           = g.network_usage_level;
+         return h;
+      }
+
+      void mirror_to( eosio_global_state& g )const {
+         g.max_ram_size                  = max_ram_size;
+         g.total_ram_bytes_reserved      = total_ram_bytes_reserved;
+         g.total_ram_stake               = total_ram_stake;
+         g.last_producer_schedule_update = last_producer_schedule_update;
+         g.last_inflation_distribution   = last_inflation_distribution;
+         g.last_producer_schedule_size   = last_producer_schedule_size;
+         g.is_producer_schedule_active   = is_producer_schedule_active;
+         g.network_usage_level           = network_usage_level;
+      }
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( eosio_global_hot_state, (max_ram_size)(total_ram_bytes_reserved)(total_ram_stake)
+                        (last_producer_schedule_update)(last_inflation_distribution)(last_producer_schedule_size)
+                        (is_producer_schedule_active)(network_usage_level)(produced_schedule_version)(produced_blocks) )
+   };
+
    /**
     * Defines new global state parameters added after version 1.0
     *
@@ -214,9 +288,24 @@ namespace eosiosystem {
       bool     active()const      { return is_active;                               }
       void     deactivate()       { producer_key = public_key(); is_active = false; }
 
-      // explicit serialization macro is not necessary, used here only to improve compilation time
-      EOSLIB_SERIALIZE( producer_info, (owner)(total_votes)(producer_key)(is_active)(url)
-                        (unpaid_blocks)(last_claim_time)(location) )
+      // fixed-size fields are copied directly, see fixed_layout.hpp
+      template<typename DataStream>
+      friend DataStream& operator<<( DataStream& ds, const producer_info& t ) {
+         fixed_layout::pack( ds, t.owner, t.total_votes );
+         ds << t.producer_key;
+         fixed_layout::pack( ds, t.is_active );
+         ds << t.url;
+         return fixed_layout::pack( ds, t.unpaid_blocks, t.last_claim_time, t.location );
+      }
+
+      template<typename DataStream>
+      friend DataStream& operator>>( DataStream& ds, producer_info& t ) {
+         fixed_layout::unpack( ds, t.owner, t.total_votes );
+         ds >> t.producer_key;
+         fixed_layout::unpack( ds, t.is_active );
+         ds >> t.url;
+         return fixed_layout::unpack( ds, t.unpaid_blocks, t.last_claim_time, t.location );
+      }
    };
 
    /**
@@ -303,6 +392,10 @@ namespace eosiosystem {
     * Global state singleton added in version 1.0
     */
    typedef eosio::singleton< "global"_n, eosio_global_state >   global_state_singleton;
+   /**
+    * Hot global state singleton split from the global state
+    */
+   typedef eosio::singleton< "globalhot"_n, eosio_global_hot_state > global_hot_state_singleton;
    /**
     * Global state singleton added in version 1.1.0
     */
@@ -324,8 +417,16 @@ namespace eosiosystem {
       }
       uint64_t primary_key()const { return owner.value; }
 
-      // explicit serialization macro is not necessary, used here only to improve compilation time
-      EOSLIB_SERIALIZE( user_resources, (owner)(net_weight)(cpu_weight)(ram_stake)(ram_bytes) )
+      // fixed-size fields are copied directly, see fixed_layout.hpp
+      template<typename DataStream>
+      friend DataStream& operator<<( DataStream& ds, const user_resources& t ) {
+         return fixed_layout::pack( ds, t.owner, t.net_weight, t.cpu_weight, t.ram_stake, t.ram_bytes );
+      }
+
+      template<typename DataStream>
+      friend DataStream& operator>>( DataStream& ds, user_resources& t ) {
+         return fixed_layout::unpack( ds, t.owner, t.net_weight, t.cpu_weight, t.ram_stake, t.ram_bytes );
+      }
    };
 
    /**
@@ -340,8 +441,16 @@ namespace eosiosystem {
       bool is_empty()const { return net_weight.amount == 0 && cpu_weight.amount == 0; }
       uint64_t  primary_key()const { return to.value; }
 
-      // explicit serialization macro is not necessary, used here only to improve compilation time
-      EOSLIB_SERIALIZE( delegated_bandwidth, (from)(to)(net_weight)(cpu_weight) )
+      // fixed-size fields are copied directly, see fixed_layout.hpp
+      template<typename DataStream>
+      friend DataStream& operator<<( DataStream& ds, const delegated_bandwidth& t ) {
+         return fixed_layout::pack( ds, t.from, t.to, t.net_weight, t.cpu_weight );
+      }
+
+      template<typename DataStream>
+      friend DataStream& operator>>( DataStream& ds, delegated_bandwidth& t ) {
+         return fixed_layout::unpack( ds, t.from, t.to, t.net_weight, t.cpu_weight );
+      }
 
    };
 
@@ -357,8 +466,16 @@ namespace eosiosystem {
       bool is_empty()const { return net_amount.amount == 0 && cpu_amount.amount == 0 && ram_amount.amount == 0 && ram_bytes == 0; }
       uint64_t  primary_key()const { return owner.value; }
 
-      // explicit serialization macro is not necessary, used here only to improve compilation time
-      EOSLIB_SERIALIZE( refund_request, (owner)(request_time)(net_amount)(cpu_amount)(ram_amount)(ram_bytes) )
+      // fixed-size fields are copied directly, see fixed_layout.hpp
+      template<typename DataStream>
+      friend DataStream& operator<<( DataStream& ds, const refund_request& t ) {
+         return fixed_layout::pack( ds, t.owner, t.request_time, t.net_amount, t.cpu_amount, t.ram_amount, t.ram_bytes );
+      }
+
+      template<typename DataStream>
+      friend DataStream& operator>>( DataStream& ds, refund_request& t ) {
+         return fixed_layout::unpack( ds, t.owner, t.request_time, t.net_amount, t.cpu_amount, t.ram_amount, t.ram_bytes );
+      }
    };
 
    /**
@@ -369,6 +486,7 @@ namespace eosiosystem {
    typedef eosio::multi_index< "delband"_n, delegated_bandwidth > del_bandwidth_table;
    typedef eosio::multi_index< "refunds"_n, refund_request >      refunds_table;
 
+#if SYSTEM_ENABLE_REX
    /**
     * `rex_pool` structure underlying the rex pool table.
     *
@@ -530,6 +648,7 @@ namespace eosiosystem {
       asset proceeds;
       asset stake_change;
    };
+#endif
 
    /**
     * The EOSIO system contract.
@@ -539,23 +658,33 @@ namespace eosiosystem {
    class [[eosio::contract("eosio.system")]] system_contract : public native {
 
       private:
-         voters_table            _voters;
-         producers_table         _producers;
+         // tables are constructed and singletons read on first use, an action only pays for what it touches
+         lazy_table<voters_table>            _voters;
+         lazy_table<producers_table>         _producers;
          //producers_table2        _producers2;
-         global_state_singleton  _global;
+         lazy_table<global_state_singleton>  _global;
          //global_state2_singleton _global2;
          //global_state3_singleton _global3;
-         eosio_global_state      _gstate;
+         std::optional<eosio_global_state> _gstate; ///< loaded on first use, see global_params()
+         lazy_table<global_hot_state_singleton> _globalhot;
+         std::optional<eosio_global_hot_state>  _ghot; ///< loaded on first use, see global_hot()
          //eosio_global_state2     _gstate2;
          //eosio_global_state3     _gstate3;
-         rammarket               _rammarket;
-         rex_pool_table          _rexpool;
-         rex_fund_table          _rexfunds;
-         rex_balance_table       _rexbalance;
-         rex_order_table         _rexorders;
-         producer_pay_table      _producer_pay;
-         worbli_params_singleton _worbliparams;
-         worbli_params           _wstate;
+         lazy_table<rammarket>               _rammarket;
+#if SYSTEM_ENABLE_REX
+         lazy_table<rex_pool_table>          _rexpool;
+         mutable std::optional<rex_pool>     _rpool; ///< loaded on first use, see get_rex_pool()
+         bool                                _rpool_modified = false;
+         lazy_table<rex_fund_table>          _rexfunds;
+         lazy_table<rex_balance_table>       _rexbalance;
+         lazy_table<rex_order_table>         _rexorders;
+#endif
+         lazy_table<producer_pay_table>      _producer_pay;
+         lazy_table<worbli_params_singleton> _worbliparams;
+         std::optional<worbli_params>        _wstate; ///< loaded on first use, see worbli_state()
+         lazy_table<producer_schedule_singleton> _prodsched;
+         lazy_table<producer_uptime_singleton>   _produptime;
+         lazy_table<uptime_counters_singleton>   _uptimectr;
 
       public:
          static constexpr eosio::name active_permission{"active"_n};
@@ -702,6 +831,7 @@ namespace eosiosystem {
          void delegatebw( const name& from, const name& receiver,
                           const asset& stake_net_quantity, const asset& stake_cpu_quantity, bool transfer );
 
+#if SYSTEM_ENABLE_REX
          /**
           * Setrex action.
           *
@@ -976,6 +1106,7 @@ namespace eosiosystem {
           */
          [[eosio::action]]
          void closerex( const name& owner );
+#endif
 
          /**
           * Undelegate bandwitdh action.
@@ -1263,12 +1394,16 @@ namespace eosiosystem {
          [[eosio::action]]
          void setwparams(uint64_t max_subaccounts);
 
+         [[eosio::action]]
+         void setinflation( uint32_t numerator, uint32_t denominator );
+
          using init_action = eosio::action_wrapper<"init"_n, &system_contract::init>;
          using setacctram_action = eosio::action_wrapper<"setacctram"_n, &system_contract::setacctram>;
          using setacctnet_action = eosio::action_wrapper<"setacctnet"_n, &system_contract::setacctnet>;
          using setacctcpu_action = eosio::action_wrapper<"setacctcpu"_n, &system_contract::setacctcpu>;
          using activate_action = eosio::action_wrapper<"activate"_n, &system_contract::activate>;
          using delegatebw_action = eosio::action_wrapper<"delegatebw"_n, &system_contract::delegatebw>;
+#if SYSTEM_ENABLE_REX
          using deposit_action = eosio::action_wrapper<"deposit"_n, &system_contract::deposit>;
          using withdraw_action = eosio::action_wrapper<"withdraw"_n, &system_contract::withdraw>;
          using buyrex_action = eosio::action_wrapper<"buyrex"_n, &system_contract::buyrex>;
@@ -1288,6 +1423,7 @@ namespace eosiosystem {
          using mvfrsavings_action = eosio::action_wrapper<"mvfrsavings"_n, &system_contract::mvfrsavings>;
          using consolidate_action = eosio::action_wrapper<"consolidate"_n, &system_contract::consolidate>;
          using closerex_action = eosio::action_wrapper<"closerex"_n, &system_contract::closerex>;
+#endif
          using undelegatebw_action = eosio::action_wrapper<"undelegatebw"_n, &system_contract::undelegatebw>;
          using buyram_action = eosio::action_wrapper<"buyram"_n, &system_contract::buyram>;
          using buyrambytes_action = eosio::action_wrapper<"buyrambytes"_n, &system_contract::buyrambytes>;
@@ -1319,9 +1455,18 @@ namespace eosiosystem {
 
          //defined in eosio.system.cpp
          static eosio_global_state get_default_parameters();
+         eosio_global_state& global_params();
+         eosio_global_hot_state& global_hot();
+         worbli_params& worbli_state();
          symbol core_symbol()const;
          void update_ram_supply();
 
+         // defined in producer_pay.cpp
+         void record_produced_block( const name& producer, uint32_t schedule_version, const block_timestamp& timestamp );
+         void rollup_produced_blocks();
+         void fold_producer_uptime( producer_uptime_counters& counters, uint32_t schedule_version, uint32_t today );
+
+#if SYSTEM_ENABLE_REX
          // defined in rex.cpp
          void runrex( uint16_t max );
          void update_resource_limits( const name& from, const name& receiver, int64_t delta_net, int64_t delta_cpu );
@@ -1340,8 +1485,10 @@ namespace eosiosystem {
          void transfer_from_fund( const name& owner, const asset& amount );
          void transfer_to_fund( const name& owner, const asset& amount );
          bool rex_loans_available()const;
-         bool rex_system_initialized()const { return _rexpool.begin() != _rexpool.end(); }
-         bool rex_available()const { return rex_system_initialized() && _rexpool.begin()->total_rex.amount > 0; }
+         bool rex_system_initialized()const { return _rpool || _rexpool->begin() != _rexpool->end(); }
+         bool rex_available()const { return rex_system_initialized() && get_rex_pool().total_rex.amount > 0; }
+         const rex_pool& get_rex_pool()const;
+         rex_pool& rex_pool_state();
          static time_point_sec get_rex_maturity();
          asset add_to_rex_balance( const name& owner, const asset& payment, const asset& rex_received );
          asset add_to_rex_pool( const asset& payment );
@@ -1356,6 +1503,7 @@ namespace eosiosystem {
          void remove_loan_from_rex_pool( const rex_loan& loan );
          template <typename Index, typename Iterator>
          int64_t update_renewed_loan( Index& idx, const Iterator& itr, int64_t rented_tokens );
+#endif
 
          // defined in delegate_bandwidth.cpp
          void changebw( name from, const name& receiver,
@@ -1404,7 +1552,9 @@ namespace eosiosystem {
                system_contract* this_contract;
          };
 
+#if SYSTEM_ENABLE_REX
          registration<&system_contract::update_rex_stake> vote_stake_updater{ this };
+#endif
    };
 
    /** @}*/ // end of @defgroup eosiosystem eosio.system
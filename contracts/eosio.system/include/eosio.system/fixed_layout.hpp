@@ -0,0 +1,96 @@
+#pragma once
+
+#include <eosio/asset.hpp>
+#include <eosio/check.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/name.hpp>
+#include <eosio/time.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+namespace eosiosystem { namespace fixed_layout {
+
+   /**
+    * Pack and unpack routines for rows made of fixed-size fields.
+    *
+    * @details The generic `EOSLIB_SERIALIZE` operators go through one datastream call per field and
+    * per nested member. These routines check the stream bounds once and copy the fields with
+    * `memcpy`, producing exactly the bytes the generic serializer would. The packed size is known at
+    * compile time, so sizing a row for `multi_index` costs nothing.
+    */
+   template<typename T, typename = void>
+   struct field_size;
+
+   template<typename T>
+   struct field_size<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>> {
+      static constexpr size_t value = sizeof(T);
+   };
+
+   template<> struct field_size<bool>                  { static constexpr size_t value = 1;  };
+   template<> struct field_size<eosio::name>           { static constexpr size_t value = 8;  };
+   template<> struct field_size<eosio::asset>          { static constexpr size_t value = 16; };
+   template<> struct field_size<eosio::time_point>     { static constexpr size_t value = 8;  };
+   template<> struct field_size<eosio::time_point_sec> { static constexpr size_t value = 4;  };
+
+   /// Bytes taken by `Fields` in a packed row
+   template<typename... Fields>
+   constexpr size_t packed_size = ( field_size<Fields>::value + ... );
+
+   template<typename T>
+   inline std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, char*> put( char* p, const T& v ) {
+      memcpy( p, &v, sizeof(T) );
+      return p + sizeof(T);
+   }
+   inline char* put( char* p, const bool& v )                  { *p = v ? 1 : 0; return p + 1; }
+   inline char* put( char* p, const eosio::name& v )           { return put( p, v.value ); }
+   inline char* put( char* p, const eosio::asset& v )          { return put( put( p, v.amount ), v.symbol.raw() ); }
+   inline char* put( char* p, const eosio::time_point& v )     { return put( p, v.elapsed.count() ); }
+   inline char* put( char* p, const eosio::time_point_sec& v ) { return put( p, v.utc_seconds ); }
+
+   template<typename T>
+   inline std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, const char*> get( const char* p, T& v ) {
+      memcpy( &v, p, sizeof(T) );
+      return p + sizeof(T);
+   }
+   inline const char* get( const char* p, bool& v )            { v = *p != 0; return p + 1; }
+   inline const char* get( const char* p, eosio::name& v )     { return get( p, v.value ); }
+   inline const char* get( const char* p, eosio::asset& v ) {
+      uint64_t raw = 0;
+      p = get( get( p, v.amount ), raw );
+      v.symbol = eosio::symbol( raw );
+      return p;
+   }
+   inline const char* get( const char* p, eosio::time_point& v ) {
+      int64_t count = 0;
+      p = get( p, count );
+      v = eosio::time_point( eosio::microseconds( count ) );
+      return p;
+   }
+   inline const char* get( const char* p, eosio::time_point_sec& v ) { return get( p, v.utc_seconds ); }
+
+   /// Writes `fields` in order, or only advances the stream when it is computing a packed size
+   template<typename DataStream, typename... Fields>
+   DataStream& pack( DataStream& ds, const Fields&... fields ) {
+      constexpr size_t size = packed_size<Fields...>;
+      if constexpr( !std::is_same_v<DataStream, eosio::datastream<size_t>> ) {
+         eosio::check( ds.remaining() >= size, "write" );
+         char* p = ds.pos();
+         ( (p = put( p, fields )), ... );
+      }
+      ds.skip( size );
+      return ds;
+   }
+
+   /// Reads `fields` in order
+   template<typename DataStream, typename... Fields>
+   DataStream& unpack( DataStream& ds, Fields&... fields ) {
+      constexpr size_t size = packed_size<Fields...>;
+      eosio::check( ds.remaining() >= size, "read" );
+      const char* p = ds.pos();
+      ( (p = get( p, fields )), ... );
+      ds.skip( size );
+      return ds;
+   }
+
+} } /// namespace eosiosystem::fixed_layout
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eosiosystem {
+
+   /**
+    * Tokens issued over `usecs` microseconds of inflation at a yearly rate of `numerator / denominator`
+    * of `supply`, rounded down.
+    *
+    * @details Computed in 128-bit fixed point, so the result is exactly reproducible and does not
+    * depend on soft-float. Kept free of contract dependencies so the tests can compare it against
+    * the floating point formula natively.
+    *
+    * @return the issued amount, or -1 if the intermediate product does not fit in 128 bits.
+    */
+   constexpr int64_t inflation_for_period( int64_t supply, int64_t usecs, uint32_t numerator, uint32_t denominator,
+                                           int64_t useconds_per_year ) {
+      using uint128 = unsigned __int128;
+
+      if( supply <= 0 || usecs <= 0 || numerator == 0 )
+         return 0;
+
+      // supply * numerator < 2^95, the product with usecs fits while usecs < 2^128 / that
+      const uint128 scaled_supply = uint128(supply) * numerator;
+      if( uint128(usecs) > ~uint128(0) / scaled_supply )
+         return -1;
+
+      const uint128 result = scaled_supply * uint128(usecs) / (uint128(useconds_per_year) * denominator);
+      if( result > uint128(INT64_MAX) )
+         return -1;
+      return int64_t(result);
+   }
+
+} /// namespace eosiosystem
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <eosio/name.hpp>
+
+#include <optional>
+
+namespace eosiosystem {
+
+   /**
+    * On-demand handle for a `multi_index` table or a `singleton`.
+    *
+    * @details The wrapped table is constructed on first access, so an action only pays for the
+    * tables it actually touches. Access goes through `->` and `*` as with a pointer.
+    *
+    * @tparam Table - the `multi_index` or `singleton` type, constructible from `(code, scope)`.
+    */
+   template<typename Table>
+   class lazy_table {
+      public:
+         lazy_table( eosio::name code, uint64_t scope )
+         :_code(code), _scope(scope) {}
+
+         Table& operator*()const {
+            if( !_table ) {
+               _table.emplace( _code, _scope );
+            }
+            return *_table;
+         }
+
+         Table* operator->()const { return &**this; }
+
+         /// Whether the table has been constructed yet
+         bool loaded()const { return _table.has_value(); }
+
+      private:
+         eosio::name                    _code;
+         uint64_t                       _scope;
+         mutable std::optional<Table>   _table;
+   };
+
+} /// namespace eosiosystem
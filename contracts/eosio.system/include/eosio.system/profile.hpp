@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * Compile-time profiling counters for the system contract.
+ *
+ * In builds with WORBLI_PROFILE, `WORBLI_PROFILE_SECTION( "name" )` opens a named section that lasts
+ * until the end of the enclosing scope. Table reads, table writes and inline actions are counted
+ * against the innermost open section by `WORBLI_PROFILE_READS( n )`, `WORBLI_PROFILE_WRITES( n )` and
+ * `WORBLI_PROFILE_INLINES( n )` at the places that perform them. A read is one row lookup or
+ * iterator step, a write one emplace, modify, erase or singleton set, and an inline one action or
+ * deferred transaction sent or cancelled. Resource limit and other intrinsics are not counted.
+ * Counts outside any section are dropped. `WORBLI_PROFILE_REPORT()` prints one console line per
+ * section that was entered:
+ *
+ *    profile <name> calls=<n> reads=<n> writes=<n> inlines=<n>
+ *
+ * Without the flag all macros expand to nothing.
+ */
+#if WORBLI_PROFILE
+
+#include <eosio/print.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace eosiosystem { namespace profile {
+
+   struct section_counters {
+      const char* name    = nullptr;
+      uint32_t    calls   = 0;
+      uint32_t    reads   = 0;
+      uint32_t    writes  = 0;
+      uint32_t    inlines = 0;
+   };
+
+   constexpr uint32_t max_sections = 16;
+
+   inline section_counters sections[max_sections];
+   inline uint32_t         section_count = 0;
+   inline section_counters* current = nullptr;
+
+   inline section_counters* find_section( const char* name ) {
+      for( uint32_t i = 0; i < section_count; ++i ) {
+         if( strcmp( sections[i].name, name ) == 0 ) return &sections[i];
+      }
+      if( section_count == max_sections ) return nullptr;
+      sections[section_count].name = name;
+      return &sections[section_count++];
+   }
+
+   /// Makes `name` the current section for the lifetime of the object
+   class scope {
+      public:
+         explicit scope( const char* name )
+         :_previous(current) {
+            current = find_section( name );
+            if( current ) ++current->calls;
+         }
+         ~scope() { current = _previous; }
+
+      private:
+         section_counters* _previous;
+   };
+
+   inline void count_reads( uint32_t n )   { if( current ) current->reads += n; }
+   inline void count_writes( uint32_t n )  { if( current ) current->writes += n; }
+   inline void count_inlines( uint32_t n ) { if( current ) current->inlines += n; }
+
+   inline void report() {
+      for( uint32_t i = 0; i < section_count; ++i ) {
+         const auto& s = sections[i];
+         eosio::print( "profile ", s.name, " calls=", s.calls, " reads=", s.reads,
+                       " writes=", s.writes, " inlines=", s.inlines, "\n" );
+      }
+   }
+
+} } /// namespace eosiosystem::profile
+
+#define WORBLI_PROFILE_CONCAT_( a, b )  a##b
+#define WORBLI_PROFILE_CONCAT( a, b )   WORBLI_PROFILE_CONCAT_( a, b )
+#define WORBLI_PROFILE_SECTION( name ) \
+   ::eosiosystem::profile::scope WORBLI_PROFILE_CONCAT( worbli_profile_scope_, __LINE__ )( name )
+#define WORBLI_PROFILE_READS( n )      ::eosiosystem::profile::count_reads( n )
+#define WORBLI_PROFILE_WRITES( n )     ::eosiosystem::profile::count_writes( n )
+#define WORBLI_PROFILE_INLINES( n )    ::eosiosystem::profile::count_inlines( n )
+#define WORBLI_PROFILE_REPORT()        ::eosiosystem::profile::report()
+
+#else
+
+#define WORBLI_PROFILE_SECTION( name )
+#define WORBLI_PROFILE_READS( n )
+#define WORBLI_PROFILE_WRITES( n )
+#define WORBLI_PROFILE_INLINES( n )
+#define WORBLI_PROFILE_REPORT()
+
+#endif
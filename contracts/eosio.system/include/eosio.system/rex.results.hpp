@@ -25,8 +25,21 @@ class [[eosio::contract("rex.results")]] rex_results : eosio::contract {
       [[eosio::action]]
       void rentresult( const asset& rented_tokens );
 
+      /// `tokens` moved by this purchase or sale, `total_ram_refund` is all the RAM refund pending for `owner` afterwards
+      [[eosio::action]]
+      void ramresult( const name& owner, int64_t bytes, const asset& tokens, const asset& total_ram_refund );
+
+      [[eosio::action]]
+      void delramresult( const name& from, const name& receiver, int64_t bytes, const asset& stake );
+
+      [[eosio::action]]
+      void claimresult( const name& owner, const asset& earned_pay );
+
       using buyresult_action   = action_wrapper<"buyresult"_n,   &rex_results::buyresult>;
       using sellresult_action  = action_wrapper<"sellresult"_n,  &rex_results::sellresult>;
       using orderresult_action = action_wrapper<"orderresult"_n, &rex_results::orderresult>;
       using rentresult_action  = action_wrapper<"rentresult"_n,  &rex_results::rentresult>;
+      using ramresult_action    = action_wrapper<"ramresult"_n,    &rex_results::ramresult>;
+      using delramresult_action = action_wrapper<"delramresult"_n, &rex_results::delramresult>;
+      using claimresult_action  = action_wrapper<"claimresult"_n,  &rex_results::claimresult>;
 };
@@ -18,8 +18,16 @@ namespace worblisystem {
 
       uint64_t  primary_key()const { return to.value; }
 
-      // explicit serialization macro is not necessary, used here only to improve compilation time
-      EOSLIB_SERIALIZE( delegated_ram, (from)(to)(ram_stake)(ram_bytes) )
+      // fixed-size fields are copied directly, see fixed_layout.hpp
+      template<typename DataStream>
+      friend DataStream& operator<<( DataStream& ds, const delegated_ram& t ) {
+         return fixed_layout::pack( ds, t.from, t.to, t.ram_stake, t.ram_bytes );
+      }
+
+      template<typename DataStream>
+      friend DataStream& operator>>( DataStream& ds, delegated_ram& t ) {
+         return fixed_layout::unpack( ds, t.from, t.to, t.ram_stake, t.ram_bytes );
+      }
 
    };
 
@@ -36,9 +44,64 @@ namespace worblisystem {
 
    struct [[eosio::table("worbliglobal"), eosio::contract("eosio.system")]] worbli_params {
       uint64_t              max_subaccounts = 1;
+      eosio::binary_extension<uint32_t> inflation_numerator;   ///< yearly inflation rate, set together with
+      eosio::binary_extension<uint32_t> inflation_denominator; ///< the denominator by `setinflation`
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( worbli_params, (max_subaccounts)(inflation_numerator)(inflation_denominator) )
+   };
+
+   /**
+    *  Active producer schedule the `produced_blocks` bitmap of the global state refers to.
+    *  Only rewritten when the active schedule changes, bit `i` belongs to `producers[i]`.
+    */
+   struct [[eosio::table("prodsched"), eosio::contract("eosio.system")]] producer_schedule_state {
+      uint32_t              schedule_version = 0;
+      std::vector<name>     producers;
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( producer_schedule_state, (schedule_version)(producers) )
+   };
+
+   struct producer_uptime_entry {
+      name                   producer;
+      uint32_t               blocks_current_day = 0;
+      uint32_t               blocks_previous_day = 0;
+      eosio::block_timestamp last_produced;
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( producer_uptime_entry, (producer)(blocks_current_day)(blocks_previous_day)(last_produced) )
+   };
+
+   /**
+    *  Uptime telemetry of `onblock`, one fixed-width entry per position in the active schedule.
+    *  `day` is the block timestamp slot divided by the blocks per day; counters of producers that
+    *  stay in the schedule are carried over when the schedule changes.
+    *
+    *  The row is only written when the day or the schedule version changes. Blocks produced since
+    *  then are counted in `uptimectr`; the current day's count of a producer is `blocks_current_day`
+    *  plus the counter at its position in `prodsched`.
+    */
+   struct [[eosio::table("produptime"), eosio::contract("eosio.system")]] producer_uptime {
+      uint32_t                             schedule_version = 0;
+      uint32_t                             day = 0;
+      std::vector<producer_uptime_entry>   producers;
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( producer_uptime, (schedule_version)(day)(producers) )
+   };
+
+   /**
+    *  Blocks produced per position of the schedule in `prodsched` since `produptime` was last
+    *  written, the only uptime state `onblock` rewrites on every block.
+    */
+   struct [[eosio::table("uptimectr"), eosio::contract("eosio.system")]] producer_uptime_counters {
+      uint32_t                              day = 0;
+      std::vector<uint32_t>                 blocks;
+      std::vector<eosio::block_timestamp>   last_produced;
 
       // explicit serialization macro is not necessary, used here only to improve compilation time
-      EOSLIB_SERIALIZE( worbli_params, (max_subaccounts) )
+      EOSLIB_SERIALIZE( producer_uptime_counters, (day)(blocks)(last_produced) )
    };
 
    struct [[eosio::table, eosio::contract("eosio.system")]] subaccount {
@@ -53,5 +116,8 @@ namespace worblisystem {
    typedef eosio::multi_index< "delram"_n, delegated_ram >        del_ram_table;
    typedef eosio::multi_index< "prodpay"_n, producer_pay >  producer_pay_table;
    typedef eosio::singleton< "worbliglobal"_n, worbli_params >   worbli_params_singleton;
+   typedef eosio::singleton< "prodsched"_n, producer_schedule_state >   producer_schedule_singleton;
+   typedef eosio::singleton< "produptime"_n, producer_uptime >   producer_uptime_singleton;
+   typedef eosio::singleton< "uptimectr"_n, producer_uptime_counters >   uptime_counters_singleton;
    typedef eosio::multi_index< "subaccounts"_n, subaccount >  subaccount_table;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <eosio/eosio.hpp>
+#include <eosio.system/profile.hpp>
 using namespace eosio;
 
 namespace worblisystem
@@ -32,6 +33,7 @@ namespace worblisystem
         {
             registry registry_table(condition.provider, account.value);
             auto itr = registry_table.find(condition.attribute.value);
+            WORBLI_PROFILE_READS( 1 );
 
             if (itr == registry_table.end() ||
                 find(condition.values.begin(), condition.values.end(), itr->value) == condition.values.end())
@@ -56,6 +58,7 @@ namespace worblisystem
     {
         registry registry_table(provider, account.value);
         auto itr = registry_table.find(attribute.value);
+        WORBLI_PROFILE_READS( 1 );
 
         if (itr != registry_table.end()) {
             char *c = new char[itr->value.size() + 1];
@@ -84,6 +87,7 @@ namespace worblisystem
     {
         registry registry_table(provider, account.value);
         auto itr = registry_table.find(attribute.value);
+        WORBLI_PROFILE_READS( 1 );
 
         if (itr != registry_table.end()) {
             if (itr->value == "true")
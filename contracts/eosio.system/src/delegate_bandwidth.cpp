@@ -6,11 +6,10 @@
 #include <eosio/transaction.hpp>
 
 #include <eosio.system/eosio.system.hpp>
+#include <eosio.system/rex.results.hpp>
 #include <eosio.system/worbli.prov.common.hpp>
 #include <eosio.token/eosio.token.hpp>
 
-#include "name_bidding.cpp"
-
 #include <cmath>
 // Unfortunately, this is needed until CDT fixes the duplicate symbol error with eosio::send_deferred
 
@@ -234,12 +233,14 @@ namespace eosiosystem {
          check( 0 <= tot_itr->cpu_weight.amount, "insufficient staked total cpu bandwidth" );
 
          {
+            WORBLI_PROFILE_SECTION( "resource limits" );
             bool ram_managed = false;
             bool net_managed = false;
             bool cpu_managed = false;
 
-            auto voter_itr = _voters.find( receiver.value );
-            if( voter_itr != _voters.end() ) {
+            auto voter_itr = _voters->find( receiver.value );
+            WORBLI_PROFILE_READS( 1 );
+            if( voter_itr != _voters->end() ) {
                ram_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed );
                net_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::net_managed );
                cpu_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::cpu_managed );
@@ -263,8 +264,10 @@ namespace eosiosystem {
 
       // create refund or update from existing refund
       if ( stake_account != source_stake_from ) { //for eosio both transfer and refund make no sense
+         WORBLI_PROFILE_SECTION( "refund handling" );
          refunds_table refunds_tbl( get_self(), from.value );
          auto req = refunds_tbl.find( from.value );
+         WORBLI_PROFILE_READS( 1 );
 
          //create/update/delete refund
          auto net_balance = stake_net_delta;
@@ -279,6 +282,7 @@ namespace eosiosystem {
 
          if( is_delegating_to_self || is_undelegating ) {
             if ( req != refunds_tbl.end() ) { //need to update refund
+               WORBLI_PROFILE_WRITES( 1 );
                refunds_tbl.modify( req, same_payer, [&]( refund_request& r ) {
                   if ( net_balance.amount < 0 || cpu_balance.amount < 0 ) {
                      r.request_time = current_time_point();
@@ -304,11 +308,13 @@ namespace eosiosystem {
 
                if ( req->is_empty() ) {
                   refunds_tbl.erase( req );
+                  WORBLI_PROFILE_WRITES( 1 );
                   need_deferred_trx = false;
                } else {
                   need_deferred_trx = true;
                }
             } else if ( net_balance.amount < 0 || cpu_balance.amount < 0 ) { //need to create refund
+               WORBLI_PROFILE_WRITES( 1 );
                refunds_tbl.emplace( from, [&]( refund_request& r ) {
                   r.owner = from;
                   if ( net_balance.amount < 0 ) {
@@ -340,14 +346,17 @@ namespace eosiosystem {
             out.delay_sec = refund_delay_sec;
             eosio::cancel_deferred( from.value ); // TODO: Remove this line when replacing deferred trxs is fixed
             out.send( from.value, from, true );
+            WORBLI_PROFILE_INLINES( 2 );
          } else {
             eosio::cancel_deferred( from.value );
+            WORBLI_PROFILE_INLINES( 1 );
          }
 
          auto transfer_amount = net_balance + cpu_balance;
          if ( 0 < transfer_amount.amount ) {
             token::transfer_action transfer_act{ token_account, { {source_stake_from, active_permission} } };
             transfer_act.send( source_stake_from, stake_account, asset(transfer_amount), "stake bandwidth" );
+            WORBLI_PROFILE_INLINES( 1 );
          }
       }
 
@@ -410,14 +419,18 @@ namespace eosiosystem {
    void system_contract::refund( const name& owner ) {
       require_auth( owner );
 
+      WORBLI_PROFILE_SECTION( "refund handling" );
       refunds_table refunds_tbl( get_self(), owner.value );
       auto req = refunds_tbl.find( owner.value );
+      WORBLI_PROFILE_READS( 1 );
       check( req != refunds_tbl.end(), "refund request not found" );
       check( req->request_time + seconds(refund_delay_sec) <= current_time_point(),
              "refund is not available yet" );
       token::transfer_action transfer_act{ token_account, { {stake_account, active_permission}, {req->owner, active_permission} } };
       transfer_act.send( stake_account, req->owner, req->net_amount + req->cpu_amount, "unstake" );
       refunds_tbl.erase( req );
+      WORBLI_PROFILE_WRITES( 1 );
+      WORBLI_PROFILE_INLINES( 1 );
    }
 
    /**
@@ -426,7 +439,7 @@ namespace eosiosystem {
    void system_contract::buyrambytes( const name& payer, const name& receiver, uint32_t bytes ) {
       const asset token_supply   = eosio::token::get_supply(token_account, core_symbol().code() );
       const uint64_t token_precision = token_supply.symbol.precision();
-      const uint64_t bytes_per_token = uint64_t((_gstate.max_ram_size / (double)token_supply.amount) * pow(10,token_precision));
+      const uint64_t bytes_per_token = uint64_t((global_hot().max_ram_size / (double)token_supply.amount) * pow(10,token_precision));
 
       auto eosout = int64_t((bytes * pow(10,token_precision)) / bytes_per_token);
 
@@ -445,12 +458,15 @@ namespace eosiosystem {
       };
 
       vector<condition> payer_check;
-      // no validation if worbli.prov account does not exist.
-      payer_check = is_account(provider_account) ? validate(payer, conditions) : payer_check;
-
       vector<condition> reciever_check;
-      // no validation if worbli.prov account does not exist.
-      reciever_check = is_account(provider_account) ? validate(payer, conditions) : reciever_check;
+      {
+         WORBLI_PROFILE_SECTION( "identity check" );
+         // no validation if worbli.prov account does not exist.
+         payer_check = is_account(provider_account) ? validate(payer, conditions) : payer_check;
+
+         // no validation if worbli.prov account does not exist.
+         reciever_check = is_account(provider_account) ? validate(payer, conditions) : reciever_check;
+      }
 
       bool can_buy = payer_check.empty();
 
@@ -461,12 +477,12 @@ namespace eosiosystem {
 
       const asset token_supply   = eosio::token::get_supply(token_account, core_symbol().code() );
       const uint64_t token_precision = token_supply.symbol.precision();
-      const uint64_t bytes_per_token = uint64_t(((_gstate.max_ram_size * pow(10,token_precision)) / (double)token_supply.amount) );
+      const uint64_t bytes_per_token = uint64_t(((global_hot().max_ram_size * pow(10,token_precision)) / (double)token_supply.amount) );
 
       uint64_t bytes_out = uint64_t(bytes_per_token * quant.amount / pow(10,token_precision));
 
-      _gstate.total_ram_bytes_reserved += uint64_t(bytes_out);
-      _gstate.total_ram_stake          += quant.amount;
+      global_hot().total_ram_bytes_reserved += uint64_t(bytes_out);
+      global_hot().total_ram_stake          += quant.amount;
 
         user_resources_table  userres( get_self(), receiver.value );
         auto res_itr = userres.find( receiver.value );
@@ -486,23 +502,31 @@ namespace eosiosystem {
                   });
         }
 
-        auto voter_itr = _voters.find( res_itr->owner.value );
-        if( voter_itr == _voters.end() || !has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed ) ) {
-           int64_t ram_bytes, net, cpu;
-           get_resource_limits( res_itr->owner, ram_bytes, net, cpu );
-           set_resource_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
+        {
+           WORBLI_PROFILE_SECTION( "resource limits" );
+           auto voter_itr = _voters->find( res_itr->owner.value );
+           WORBLI_PROFILE_READS( 1 );
+           if( voter_itr == _voters->end() || !has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed ) ) {
+              int64_t ram_bytes, net, cpu;
+              get_resource_limits( res_itr->owner, ram_bytes, net, cpu );
+              set_resource_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
+           }
         }
 
+      asset total_ram_refund( 0, core_symbol() );
       // create refund or update from existing refund
       if ( "eosio.stake"_n != receiver ) { //for eosio both transfer and refund make no sense
+         WORBLI_PROFILE_SECTION( "refund handling" );
          refunds_table refunds_tbl( get_self(), receiver.value );
          auto req = refunds_tbl.find( receiver.value );
+         WORBLI_PROFILE_READS( 1 );
 
          //create/update/delete refund
          auto ram_balance = quant;
          bool need_deferred_trx = false;
 
          if ( req != refunds_tbl.end() ) { //need to update refund
+            WORBLI_PROFILE_WRITES( 1 );
             refunds_tbl.modify( req, same_payer, [&]( refund_request& r ) {
                 r.request_time = current_time_point();
                 r.ram_amount -= ram_balance;
@@ -517,10 +541,12 @@ namespace eosiosystem {
              });
 
              check( 0 <= req->ram_amount.amount, "negative ram refund amount" ); //should never happen
+             total_ram_refund = req->ram_amount;
 
              if ( req->net_amount.amount == 0 && req->cpu_amount.amount == 0 && req->ram_bytes == 0 &&
                 req->ram_amount.amount == 0 ) {
                 refunds_tbl.erase( req );
+                WORBLI_PROFILE_WRITES( 1 );
                 need_deferred_trx = false;
              } else {
                 need_deferred_trx = true;
@@ -533,16 +559,26 @@ namespace eosiosystem {
             out.delay_sec = refund_delay_sec;
             eosio::cancel_deferred( receiver.value ); // TODO: Remove this line when replacing deferred trxs is fixed
             out.send( receiver.value, receiver, true );
+            WORBLI_PROFILE_INLINES( 2 );
          } else {
             eosio::cancel_deferred( receiver.value );
+            WORBLI_PROFILE_INLINES( 1 );
          }
 
          auto transfer_amount = ram_balance;
          if ( 0 < transfer_amount.amount ) {
             token::transfer_action transfer_act{ token_account, { {payer, active_permission} } };
             transfer_act.send( payer, stake_account, asset(transfer_amount), "stake ram" );
+            WORBLI_PROFILE_INLINES( 1 );
          }
       }
+
+#if SYSTEM_ENABLE_REX
+      // dummy action added so that the purchased bytes show up in action trace, rex.results
+      // only runs on eosio.rex when REX is enabled
+      rex_results::ramresult_action ramresult_act{ rex_account, std::vector<eosio::permission_level>{ } };
+      ramresult_act.send( receiver, int64_t(bytes_out), quant, total_ram_refund );
+#endif
   }
 
   /**
@@ -584,35 +620,42 @@ namespace eosiosystem {
 
       check( tokens_out.amount > 1, "token amount received from selling ram is too low" );
 
-      _gstate.total_ram_bytes_reserved -= static_cast<decltype(_gstate.total_ram_bytes_reserved)>(bytes); // bytes > 0 is asserted above
-      _gstate.total_ram_stake          -= tokens_out.amount;
+      global_hot().total_ram_bytes_reserved -= static_cast<decltype(global_hot().total_ram_bytes_reserved)>(bytes); // bytes > 0 is asserted above
+      global_hot().total_ram_stake          -= tokens_out.amount;
 
       //// this shouldn't happen, but just in case it does we should prevent it
-      check( _gstate.total_ram_stake >= 0, "error, attempt to unstake more tokens than previously staked" );
+      check( global_hot().total_ram_stake >= 0, "error, attempt to unstake more tokens than previously staked" );
 
       userres.modify( res_itr, account, [&]( auto& res ) {
           res.ram_bytes -= bytes;
           res.ram_stake -= tokens_out;
       });
 
-      auto voter_itr = _voters.find( res_itr->owner.value );
-      if( voter_itr == _voters.end() || !has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed ) ) {
-         int64_t ram_bytes, net, cpu;
-         get_resource_limits( res_itr->owner, ram_bytes, net, cpu );
-         set_resource_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
-
+      {
+         WORBLI_PROFILE_SECTION( "resource limits" );
+         auto voter_itr = _voters->find( res_itr->owner.value );
+         WORBLI_PROFILE_READS( 1 );
+         if( voter_itr == _voters->end() || !has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed ) ) {
+            int64_t ram_bytes, net, cpu;
+            get_resource_limits( res_itr->owner, ram_bytes, net, cpu );
+            set_resource_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
+         }
       }
 
-            // create refund or update from existing refund
+      asset total_ram_refund( 0, core_symbol() );
+      // create refund or update from existing refund
       if ( "eosio.stake"_n != account ) { //for eosio both transfer and refund make no sense
+         WORBLI_PROFILE_SECTION( "refund handling" );
          refunds_table refunds_tbl( get_self(), account.value );
          auto req = refunds_tbl.find( account.value );
+         WORBLI_PROFILE_READS( 1 );
 
          //create/update/delete refund
          auto ram_balance = tokens_out;
          bool need_deferred_trx = false;
 
             if ( req != refunds_tbl.end() ) { //need to update refund
+               WORBLI_PROFILE_WRITES( 1 );
                refunds_tbl.modify( req, same_payer, [&]( refund_request& r ) {
                   r.request_time = current_time_point();
                   r.ram_amount += ram_balance;
@@ -622,12 +665,14 @@ namespace eosiosystem {
                if ( req->net_amount.amount == 0 && req->cpu_amount.amount == 0 && req->ram_bytes == 0 &&
                   req->ram_amount.amount == 0 ) {
                   refunds_tbl.erase( req );
+                  WORBLI_PROFILE_WRITES( 1 );
                   need_deferred_trx = false;
                } else {
                   need_deferred_trx = true;
                }
 
             } else { //need to create refund
+               WORBLI_PROFILE_WRITES( 1 );
                refunds_tbl.emplace( account, [&]( refund_request& r ) {
                   r.owner = account;
                   r.ram_amount = ram_balance;
@@ -640,16 +685,26 @@ namespace eosiosystem {
             } // else stake increase requested with no existing row in refunds_tbl -> nothing to do with refunds_tbl
 
          if ( need_deferred_trx ) {
+            total_ram_refund = refunds_tbl.get( account.value ).ram_amount;
+            WORBLI_PROFILE_READS( 1 );
             eosio::transaction out;
             out.actions.emplace_back( permission_level{ account, active_permission }, get_self(), "refund"_n, account );
             out.delay_sec = refund_delay_sec;
             eosio::cancel_deferred( account.value ); // TODO: Remove this line when replacing deferred trxs is fixed
             out.send( account.value, account, true );
+            WORBLI_PROFILE_INLINES( 2 );
          } else {
             eosio::cancel_deferred( account.value );
+            WORBLI_PROFILE_INLINES( 1 );
          }
       }
       // need to update voting power
+
+#if SYSTEM_ENABLE_REX
+      // dummy action added so that the sold bytes and the refund now pending in total show up in action trace
+      rex_results::ramresult_action ramresult_act{ rex_account, std::vector<eosio::permission_level>{ } };
+      ramresult_act.send( account, -bytes, tokens_out, total_ram_refund );
+#endif
    }
 
 
@@ -4,6 +4,8 @@
 #include <eosio/crypto.hpp>
 #include <eosio/dispatcher.hpp>
 
+#include <arena_allocator.hpp>
+
 #include "worbli.cpp"
 
 namespace eosiosystem {
@@ -17,21 +19,25 @@ namespace eosiosystem {
     _producers(get_self(), get_self().value),
     //_producers2(get_self(), get_self().value),
     _global(get_self(), get_self().value),
+    _globalhot(get_self(), get_self().value),
     //_global2(get_self(), get_self().value),
     //_global3(get_self(), get_self().value),
     _rammarket(get_self(), get_self().value),
+#if SYSTEM_ENABLE_REX
     _rexpool(get_self(), get_self().value),
     _rexfunds(get_self(), get_self().value),
     _rexbalance(get_self(), get_self().value),
     _rexorders(get_self(), get_self().value),
+#endif
     _producer_pay(get_self(), get_self().value),
-    _worbliparams(get_self(), get_self().value)
+    _worbliparams(get_self(), get_self().value),
+    _prodsched(get_self(), get_self().value),
+    _produptime(get_self(), get_self().value),
+    _uptimectr(get_self(), get_self().value)
    {
       //print( "construct system\n" );
-      _gstate  = _global.exists() ? _global.get() : get_default_parameters();
       //_gstate2 = _global2.exists() ? _global2.get() : eosio_global_state2{};
       //_gstate3 = _global3.exists() ? _global3.get() : eosio_global_state3{};
-      _wstate = _worbliparams.exists() ? _worbliparams.get() : worbli_params{0};
    }
 
    eosio_global_state system_contract::get_default_parameters() {
@@ -40,36 +46,77 @@ namespace eosiosystem {
       return dp;
    }
 
+   eosio_global_state& system_contract::global_params() {
+      if( !_gstate ) {
+         _gstate = _global->exists() ? _global->get() : get_default_parameters();
+      }
+      return *_gstate;
+   }
+
+   eosio_global_hot_state& system_contract::global_hot() {
+      if( !_ghot ) {
+         _ghot = _globalhot->exists() ? _globalhot->get() : eosio_global_hot_state::from( global_params() );
+      }
+      return *_ghot;
+   }
+
+   worbli_params& system_contract::worbli_state() {
+      if( !_wstate ) {
+         _wstate = _worbliparams->exists() ? _worbliparams->get() : worbli_params{0};
+      }
+      return *_wstate;
+   }
+
    symbol system_contract::core_symbol()const {
-      const static auto sym = get_core_symbol( _rammarket );
+      const static auto sym = get_core_symbol( *_rammarket );
       return sym;
    }
 
    system_contract::~system_contract() {
-      _global.set( _gstate, get_self() );
+      // only state an action loaded is written back
+      if( _gstate ) {
+         global_hot().mirror_to( *_gstate );
+         _global->set( *_gstate, get_self() );
+      }
+      if( _ghot ) {
+         _globalhot->set( *_ghot, get_self() );
+      }
       //_global2.set( _gstate2, get_self() );
       //_global3.set( _gstate3, get_self() );
-      _worbliparams.set( _wstate, get_self() );
+      if( _wstate ) {
+         _worbliparams->set( *_wstate, get_self() );
+      }
+#if SYSTEM_ENABLE_REX
+      if( _rpool_modified ) {
+         _rexpool->modify( _rexpool->begin(), same_payer, [&]( auto& rp ) {
+            rp = *_rpool;
+         });
+      }
+#endif
+      CONTRACT_MEMORY_REPORT();
+      WORBLI_PROFILE_REPORT();
    }
 
    void system_contract::setram( uint64_t max_ram_size ) {
       require_auth( get_self() );
 
-      check( _gstate.max_ram_size < max_ram_size, "ram may only be increased" ); /// decreasing ram might result market maker issues
+      check( global_hot().max_ram_size < max_ram_size, "ram may only be increased" ); /// decreasing ram might result market maker issues
       check( max_ram_size < 1024ll*1024*1024*1024*1024, "ram size is unrealistic" );
-      check( max_ram_size > _gstate.total_ram_bytes_reserved, "attempt to set max below reserved" );
+      check( max_ram_size > global_hot().total_ram_bytes_reserved, "attempt to set max below reserved" );
 
-      auto delta = int64_t(max_ram_size) - int64_t(_gstate.max_ram_size);
-      auto itr = _rammarket.find(ramcore_symbol.raw());
+#if SYSTEM_ENABLE_RAMMARKET
+      auto delta = int64_t(max_ram_size) - int64_t(global_hot().max_ram_size);
+      auto itr = _rammarket->find(ramcore_symbol.raw());
 
       /**
        *  Increase the amount of ram for sale based upon the change in max ram size.
        */
-      _rammarket.modify( itr, same_payer, [&]( auto& m ) {
+      _rammarket->modify( itr, same_payer, [&]( auto& m ) {
          m.base.balance.amount += delta;
       });
+#endif
 
-      _gstate.max_ram_size = max_ram_size;
+      global_hot().max_ram_size = max_ram_size;
    }
 /**
    void system_contract::update_ram_supply() {
@@ -100,8 +147,9 @@ namespace eosiosystem {
 
    void system_contract::setparams( const eosio::blockchain_parameters& params ) {
       require_auth( get_self() );
-      (eosio::blockchain_parameters&)(_gstate) = params;
-      check( 3 <= _gstate.max_authority_depth, "max_authority_depth should be at least 3" );
+      auto& gstate = global_params();
+      (eosio::blockchain_parameters&)(gstate) = params;
+      check( 3 <= gstate.max_authority_depth, "max_authority_depth should be at least 3" );
       set_blockchain_parameters( params );
    }
 
@@ -117,8 +165,8 @@ namespace eosiosystem {
       auto ritr = userres.find( account.value );
       check( ritr == userres.end(), "only supports unlimited accounts" );
 
-      auto vitr = _voters.find( account.value );
-      if( vitr != _voters.end() ) {
+      auto vitr = _voters->find( account.value );
+      if( vitr != _voters->end() ) {
          bool ram_managed = has_field( vitr->flags1, voter_info::flags1_fields::ram_managed );
          bool net_managed = has_field( vitr->flags1, voter_info::flags1_fields::net_managed );
          bool cpu_managed = has_field( vitr->flags1, voter_info::flags1_fields::cpu_managed );
@@ -137,8 +185,8 @@ namespace eosiosystem {
       int64_t ram = 0;
 
       if( !ram_bytes ) {
-         auto vitr = _voters.find( account.value );
-         check( vitr != _voters.end() && has_field( vitr->flags1, voter_info::flags1_fields::ram_managed ),
+         auto vitr = _voters->find( account.value );
+         check( vitr != _voters->end() && has_field( vitr->flags1, voter_info::flags1_fields::ram_managed ),
                 "RAM of account is already unmanaged" );
 
          user_resources_table userres( get_self(), account.value );
@@ -149,19 +197,19 @@ namespace eosiosystem {
             ram += ritr->ram_bytes;
          }
 
-         _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         _voters->modify( vitr, same_payer, [&]( auto& v ) {
             v.flags1 = set_field( v.flags1, voter_info::flags1_fields::ram_managed, false );
          });
       } else {
          check( *ram_bytes >= 0, "not allowed to set RAM limit to unlimited" );
 
-         auto vitr = _voters.find( account.value );
-         if ( vitr != _voters.end() ) {
-            _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         auto vitr = _voters->find( account.value );
+         if ( vitr != _voters->end() ) {
+            _voters->modify( vitr, same_payer, [&]( auto& v ) {
                v.flags1 = set_field( v.flags1, voter_info::flags1_fields::ram_managed, true );
             });
          } else {
-            _voters.emplace( account, [&]( auto& v ) {
+            _voters->emplace( account, [&]( auto& v ) {
                v.owner  = account;
                v.flags1 = set_field( v.flags1, voter_info::flags1_fields::ram_managed, true );
             });
@@ -182,8 +230,8 @@ namespace eosiosystem {
       int64_t net = 0;
 
       if( !net_weight ) {
-         auto vitr = _voters.find( account.value );
-         check( vitr != _voters.end() && has_field( vitr->flags1, voter_info::flags1_fields::net_managed ),
+         auto vitr = _voters->find( account.value );
+         check( vitr != _voters->end() && has_field( vitr->flags1, voter_info::flags1_fields::net_managed ),
                 "Network bandwidth of account is already unmanaged" );
 
          user_resources_table userres( get_self(), account.value );
@@ -193,19 +241,19 @@ namespace eosiosystem {
             net = ritr->net_weight.amount;
          }
 
-         _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         _voters->modify( vitr, same_payer, [&]( auto& v ) {
             v.flags1 = set_field( v.flags1, voter_info::flags1_fields::net_managed, false );
          });
       } else {
          check( *net_weight >= -1, "invalid value for net_weight" );
 
-         auto vitr = _voters.find( account.value );
-         if ( vitr != _voters.end() ) {
-            _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         auto vitr = _voters->find( account.value );
+         if ( vitr != _voters->end() ) {
+            _voters->modify( vitr, same_payer, [&]( auto& v ) {
                v.flags1 = set_field( v.flags1, voter_info::flags1_fields::net_managed, true );
             });
          } else {
-            _voters.emplace( account, [&]( auto& v ) {
+            _voters->emplace( account, [&]( auto& v ) {
                v.owner  = account;
                v.flags1 = set_field( v.flags1, voter_info::flags1_fields::net_managed, true );
             });
@@ -226,8 +274,8 @@ namespace eosiosystem {
       int64_t cpu = 0;
 
       if( !cpu_weight ) {
-         auto vitr = _voters.find( account.value );
-         check( vitr != _voters.end() && has_field( vitr->flags1, voter_info::flags1_fields::cpu_managed ),
+         auto vitr = _voters->find( account.value );
+         check( vitr != _voters->end() && has_field( vitr->flags1, voter_info::flags1_fields::cpu_managed ),
                 "CPU bandwidth of account is already unmanaged" );
 
          user_resources_table userres( get_self(), account.value );
@@ -237,19 +285,19 @@ namespace eosiosystem {
             cpu = ritr->cpu_weight.amount;
          }
 
-         _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         _voters->modify( vitr, same_payer, [&]( auto& v ) {
             v.flags1 = set_field( v.flags1, voter_info::flags1_fields::cpu_managed, false );
          });
       } else {
          check( *cpu_weight >= -1, "invalid value for cpu_weight" );
 
-         auto vitr = _voters.find( account.value );
-         if ( vitr != _voters.end() ) {
-            _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         auto vitr = _voters->find( account.value );
+         if ( vitr != _voters->end() ) {
+            _voters->modify( vitr, same_payer, [&]( auto& v ) {
                v.flags1 = set_field( v.flags1, voter_info::flags1_fields::cpu_managed, true );
             });
          } else {
-            _voters.emplace( account, [&]( auto& v ) {
+            _voters->emplace( account, [&]( auto& v ) {
                v.owner  = account;
                v.flags1 = set_field( v.flags1, voter_info::flags1_fields::cpu_managed, true );
             });
@@ -268,9 +316,9 @@ namespace eosiosystem {
 
    void system_contract::rmvproducer( const name& producer ) {
       require_auth( "worbli.admin"_n );
-      auto prod = _producers.find( producer.value );
-      check( prod != _producers.end(), "producer not found" );
-      _producers.erase( prod );
+      auto prod = _producers->find( producer.value );
+      check( prod != _producers->end(), "producer not found" );
+      _producers->erase( prod );
    }
 /**
    void system_contract::updtrevision( uint8_t revision ) {
@@ -349,24 +397,26 @@ namespace eosiosystem {
       require_auth( get_self() );
       check( version.value == 0, "unsupported version for init action" );
 
-      auto itr = _rammarket.find(ramcore_symbol.raw());
-      check( itr == _rammarket.end(), "system contract has already been initialized" );
+      auto itr = _rammarket->find(ramcore_symbol.raw());
+      check( itr == _rammarket->end(), "system contract has already been initialized" );
 
       auto system_token_supply   = eosio::token::get_supply(token_account, core.code() );
       check( system_token_supply.symbol == core, "specified core symbol does not exist (precision mismatch)" );
 
       check( system_token_supply.amount > 0, "system token supply must be greater than 0" );
-      _rammarket.emplace( get_self(), [&]( auto& m ) {
+      _rammarket->emplace( get_self(), [&]( auto& m ) {
          m.supply.amount = 100000000000000ll;
          m.supply.symbol = ramcore_symbol;
-         m.base.balance.amount = int64_t(_gstate.free_ram());
+         m.base.balance.amount = int64_t(global_hot().free_ram());
          m.base.balance.symbol = ram_symbol;
          m.quote.balance.amount = system_token_supply.amount / 1000;
          m.quote.balance.symbol = core;
       });
 
+#if SYSTEM_ENABLE_REX
       token::open_action open_act{ token_account, { {get_self(), active_permission} } };
       open_act.send( rex_account, core, get_self() );
+#endif
    }
 
 } /// eosio.system
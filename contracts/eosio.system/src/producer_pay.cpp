@@ -1,6 +1,9 @@
 #include <eosio.system/eosio.system.hpp>
+#include <eosio.system/rex.results.hpp>
 #include <eosio.token/eosio.token.hpp>
 
+#include <eosio/producer_schedule.hpp>
+
 namespace eosiosystem {
 
    using eosio::current_time_point;
@@ -16,41 +19,37 @@ namespace eosiosystem {
 
       block_timestamp timestamp;
       name producer;
-      _ds >> timestamp >> producer;
+      uint16_t confirmed;
+      checksum256 previous_block_id, transaction_mroot, action_mroot;
+      uint32_t schedule_version;
+      _ds >> timestamp >> producer >> confirmed >> previous_block_id >> transaction_mroot >> action_mroot >> schedule_version;
 
       /** until activated no new rewards are paid */
-      if( !_gstate.is_producer_schedule_active )
+      if( !global_hot().is_producer_schedule_active )
          return;
 
-      if( _gstate.last_inflation_distribution == time_point() ) /// start the presses
-         _gstate.last_inflation_distribution = ct;
-
-      /**
-       * At startup the initial producer may not be one that is registered / elected
-       * and therefore there may be no producer object for them.
-       */
+      if( global_hot().last_inflation_distribution == time_point() ) /// start the presses
+         global_hot().last_inflation_distribution = ct;
 
-      auto prod = _producers.find( producer.value );
-      if ( prod != _producers.end() ) {
-         //_gstate.total_unpaid_blocks++;
-         _producers.modify( prod, same_payer, [&](auto& p ) {
-            if( p.producer_key != eosio::public_key() ) {
-               p.unpaid_blocks = 1;
-            }
-         });
-      }
+      record_produced_block( producer, schedule_version, timestamp );
 
       /// only update block producers once every minute, block_timestamp is in half seconds
-      if( timestamp.slot - _gstate.last_producer_schedule_update.slot > 120 ) {
+      if( timestamp.slot - global_hot().last_producer_schedule_update.slot > 120 ) {
          update_elected_producers( timestamp );
       }
 
 
       /// only distribute inflation once a day
-      if( ct - _gstate.last_inflation_distribution > microseconds(useconds_per_day) ) {
+      if( ct - global_hot().last_inflation_distribution > microseconds(useconds_per_day) ) {
+         WORBLI_PROFILE_SECTION( "producer pay" );
          const asset token_supply   = eosio::token::get_supply(token_account, core_symbol().code() );
-         const auto usecs_since_last_fill = ct - _gstate.last_inflation_distribution;
-         auto new_tokens = static_cast<int64_t>( (continuous_rate * double(token_supply.amount) * double(usecs_since_last_fill.count())) / double(useconds_per_year) );
+         WORBLI_PROFILE_READS( 1 );
+         const auto usecs_since_last_fill = ct - global_hot().last_inflation_distribution;
+         const auto new_tokens = inflation_for_period( token_supply.amount, usecs_since_last_fill.count(),
+                                                       worbli_state().inflation_numerator.value_or( default_inflation_numerator ),
+                                                       worbli_state().inflation_denominator.value_or( default_inflation_denominator ),
+                                                       useconds_per_year );
+         check( new_tokens >= 0, "inflation overflow" );
 
       /** Percentages are fixed point with a denominator of 1000 */
          const uint16_t base_producer_rate = 250; // 25%
@@ -58,10 +57,10 @@ namespace eosiosystem {
 
          uint16_t actual_producer_rate = 0;   
 
-         if(_gstate.network_usage_level == 0)
+         if(global_hot().network_usage_level == 0)
             actual_producer_rate = base_producer_rate;
-         else if((_gstate.network_usage_level < 30))
-            actual_producer_rate = base_producer_rate + incremental_usage_rate * _gstate.network_usage_level;
+         else if((global_hot().network_usage_level < 30))
+            actual_producer_rate = base_producer_rate + incremental_usage_rate * global_hot().network_usage_level;
          else
             actual_producer_rate = 1000;
 
@@ -69,75 +68,212 @@ namespace eosiosystem {
          auto to_producers       = (max_to_producers * actual_producer_rate) / 1000;
          auto to_savings         = max_to_producers + max_to_producers - to_producers;
          auto to_usage           = new_tokens - (to_producers + to_savings);
+
+         rollup_produced_blocks();
          {
-            token::issue_action issue_act{ token_account, { {get_self(), active_permission} } };
-            issue_act.send( get_self(), asset(new_tokens, core_symbol()), "issue tokens for producer pay and savings" );
-         }
-         {
-            token::transfer_action transfer_act{ token_account, { {get_self(), active_permission} } };
-            transfer_act.send( get_self(), saving_account, asset(to_savings, core_symbol()), "unallocated inflation" );
-            transfer_act.send( get_self(), ppay_account, asset(to_producers, core_symbol()), "fund producer account" );
-            transfer_act.send( get_self(), usage_account, asset(to_usage, core_symbol()), "fund usage account" );
+            token::issuemany_action issuemany_act{ token_account, { {get_self(), active_permission} } };
+            issuemany_act.send( std::vector<token::payment>{
+               { saving_account, asset(to_savings, core_symbol()), "unallocated inflation" },
+               { ppay_account, asset(to_producers, core_symbol()), "fund producer account" },
+               { usage_account, asset(to_usage, core_symbol()), "fund usage account" }
+            } );
+            WORBLI_PROFILE_INLINES( 1 );
          }
 
         std::vector< name > active_producers;
-        for( const auto& p : _producers ) {
+        for( const auto& p : *_producers ) {
+            WORBLI_PROFILE_READS( 1 );
             if( p.active() ) {
                 active_producers.emplace_back( p.owner );
             }                
         }    
 
-        check( active_producers.size() == _gstate.last_producer_schedule_size, "active_producers must equal last_producer_schedule_size" );   
+        check( active_producers.size() == global_hot().last_producer_schedule_size, "active_producers must equal last_producer_schedule_size" );   
 
         uint64_t earned_pay = uint64_t(to_producers / active_producers.size());
         for( const auto& p : active_producers ) {
 
-            auto pay_itr = _producer_pay.find( p.value );        
+            auto pay_itr = _producer_pay->find( p.value );        
+            WORBLI_PROFILE_READS( 1 );
+            WORBLI_PROFILE_WRITES( 1 );
 
-            if( pay_itr ==  _producer_pay.end() ) {
-                pay_itr = _producer_pay.emplace( p, [&]( auto& pay ) {
+            if( pay_itr ==  _producer_pay->end() ) {
+                pay_itr = _producer_pay->emplace( p, [&]( auto& pay ) {
                     pay.owner = p;
                     pay.earned_pay = earned_pay;
                 });
             } else {
-                _producer_pay.modify( pay_itr, same_payer, [&]( auto& pay ) {
+                _producer_pay->modify( pay_itr, same_payer, [&]( auto& pay ) {
                     pay.earned_pay += earned_pay;
                 });
             }              
         }   
 
-        _gstate.last_inflation_distribution = ct;
+        global_hot().last_inflation_distribution = ct;
+
+      }
+
+   }
+
+   /**
+    *  Marks `producer` as having produced in the hot global state, which is written back by every
+    *  action anyway, instead of rewriting its producer row on every block. The producer rows
+    *  are only touched when the marks are rolled up. The uptime counters of the block go to
+    *  `uptimectr`, and into `produptime` at day and schedule changes.
+    */
+   void system_contract::record_produced_block( const name& producer, uint32_t schedule_version, const block_timestamp& timestamp ) {
+      const uint32_t today = timestamp.slot / blocks_per_day;
+      auto counters = _uptimectr->get_or_default();
+      WORBLI_PROFILE_READS( 1 );
+      if( !global_hot().produced_schedule_version || *global_hot().produced_schedule_version != schedule_version ) {
+         /// the marks and counters refer to positions in the previous schedule
+         rollup_produced_blocks();
+         fold_producer_uptime( counters, schedule_version, today );
+         _prodsched->set( producer_schedule_state{ schedule_version, eosio::get_active_producers() }, get_self() );
+         global_hot().produced_schedule_version.emplace( schedule_version );
+      } else if( counters.day != today ) {
+         fold_producer_uptime( counters, schedule_version, today );
+      }
+
+      /// same order as the recorded schedule, without reading it back from the database
+      const auto  producers = eosio::get_active_producers();
+      const auto  itr       = std::find( producers.begin(), producers.end(), producer );
+      const auto  position  = std::distance( producers.begin(), itr );
+      if( itr != producers.end() ) {
+         ++counters.blocks[position];
+         counters.last_produced[position] = timestamp;
+      }
+      _uptimectr->set( counters, get_self() );
+      WORBLI_PROFILE_WRITES( 1 );
+      if( itr != producers.end() && position < 64 ) {
+         global_hot().produced_blocks |= uint64_t(1) << position;
+         return;
+      }
+
+      /**
+       * At startup the initial producer may not be one that is registered / elected
+       * and therefore there may be no producer object for them.
+       */
+      auto prod = _producers->find( producer.value );
+      WORBLI_PROFILE_READS( 1 );
+      if ( prod != _producers->end() && prod->producer_key != eosio::public_key() && prod->unpaid_blocks != 1 ) {
+         _producers->modify( prod, same_payer, [&](auto& p ) {
+            p.unpaid_blocks = 1;
+         });
+         WORBLI_PROFILE_WRITES( 1 );
+      }
+   }
+
+   void system_contract::rollup_produced_blocks() {
+      const uint64_t produced = global_hot().produced_blocks;
+      if( produced == 0 )
+         return;
 
+      const auto producers = _prodsched->get_or_default().producers;
+      WORBLI_PROFILE_READS( 1 );
+      for( size_t i = 0; i < producers.size() && i < 64; ++i ) {
+         if( (produced & (uint64_t(1) << i)) == 0 )
+            continue;
+
+         auto prod = _producers->find( producers[i].value );
+         WORBLI_PROFILE_READS( 1 );
+         if ( prod != _producers->end() && prod->producer_key != eosio::public_key() && prod->unpaid_blocks != 1 ) {
+            _producers->modify( prod, same_payer, [&](auto& p ) {
+               p.unpaid_blocks = 1;
+            });
+            WORBLI_PROFILE_WRITES( 1 );
+         }
+      }
+      global_hot().produced_blocks = 0;
+   }
+
+   void system_contract::fold_producer_uptime( producer_uptime_counters& counters, uint32_t schedule_version, uint32_t today ) {
+      auto uptime = _produptime->get_or_default();
+      WORBLI_PROFILE_READS( 1 );
+
+      /// the counters belong to the day of the row and to the positions of the recorded schedule
+      if( !counters.blocks.empty() ) {
+         const auto positions = _prodsched->get_or_default().producers;
+         WORBLI_PROFILE_READS( 1 );
+         for( size_t i = 0; i < counters.blocks.size() && i < positions.size(); ++i ) {
+            if( counters.blocks[i] == 0 )
+               continue;
+            auto itr = std::find_if( uptime.producers.begin(), uptime.producers.end(),
+                                     [&]( const auto& e ) { return e.producer == positions[i]; } );
+            if( itr == uptime.producers.end() )
+               itr = uptime.producers.insert( itr, producer_uptime_entry{ positions[i] } );
+            itr->blocks_current_day += counters.blocks[i];
+            itr->last_produced       = counters.last_produced[i];
+         }
       }
 
+      if( uptime.day != today ) {
+         for( auto& e : uptime.producers ) {
+            e.blocks_previous_day = (uptime.day + 1 == today) ? e.blocks_current_day : 0;
+            e.blocks_current_day  = 0;
+         }
+         uptime.day = today;
+      }
+
+      /// realign with the active schedule, keeping the counters of producers that stay in it
+      const auto active = eosio::get_active_producers();
+      std::vector<producer_uptime_entry> entries;
+      entries.reserve( active.size() );
+      for( const auto& p : active ) {
+         auto itr = std::find_if( uptime.producers.begin(), uptime.producers.end(),
+                                  [&]( const auto& e ) { return e.producer == p; } );
+         entries.emplace_back( itr != uptime.producers.end() ? *itr : producer_uptime_entry{ p } );
+      }
+      uptime.producers        = std::move( entries );
+      uptime.schedule_version = schedule_version;
+
+      _produptime->set( uptime, get_self() );
+      WORBLI_PROFILE_WRITES( 1 );
+
+      counters.day = today;
+      counters.blocks.assign( active.size(), 0 );
+      counters.last_produced.assign( active.size(), block_timestamp() );
    }
 
    void system_contract::claimrewards( const name& owner ) {
       require_auth(owner);
 
-      const auto& prod = _producers.get( owner.value );
+      WORBLI_PROFILE_SECTION( "producer pay" );
+      const auto& prod = _producers->get( owner.value );
+      WORBLI_PROFILE_READS( 1 );
       check( prod.active(), "producer does not have an active key" );
                     
       auto ct = current_time_point();
 
       //producer_pay_table  pay_tbl( _self, _self );
-      auto pay = _producer_pay.find( owner.value );
-      check( pay != _producer_pay.end(), "producer pay request not found" );
+      auto pay = _producer_pay->find( owner.value );
+      WORBLI_PROFILE_READS( 1 );
+      check( pay != _producer_pay->end(), "producer pay request not found" );
       check( ct - prod.last_claim_time > microseconds(useconds_per_day), "already claimed rewards within past day" );
 
       uint64_t earned_pay = pay->earned_pay;
 
-     _producer_pay.erase( pay );
+     _producer_pay->erase( pay );
+      WORBLI_PROFILE_WRITES( 1 );
 
-      _producers.modify( prod, same_payer, [&](auto& p) {
+      _producers->modify( prod, same_payer, [&](auto& p) {
           p.last_claim_time = ct;
       });
+      WORBLI_PROFILE_WRITES( 1 );
 
       if( earned_pay > 0 ) {
          token::transfer_action transfer_act{ token_account, { {ppay_account, active_permission}, {owner, active_permission} } };
          transfer_act.send( ppay_account, owner, asset(earned_pay, core_symbol()), "producer pay" );
+         WORBLI_PROFILE_INLINES( 1 );
       }
 
+#if SYSTEM_ENABLE_REX
+      // dummy action added so that the claimed pay shows up in action trace
+      rex_results::claimresult_action claimresult_act{ rex_account, std::vector<eosio::permission_level>{ } };
+      claimresult_act.send( owner, asset(earned_pay, core_symbol()) );
+      WORBLI_PROFILE_INLINES( 1 );
+#endif
+
    }
 
 } //namespace eosiosystem
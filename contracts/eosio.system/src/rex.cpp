@@ -99,7 +99,7 @@ namespace eosiosystem {
 
       runrex(2);
 
-      auto bitr = _rexbalance.require_find( from.value, "user must first buyrex" );
+      auto bitr = _rexbalance->require_find( from.value, "user must first buyrex" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol,
              "asset must be a positive amount of (REX, 4)" );
       process_rex_maturities( bitr );
@@ -118,9 +118,9 @@ namespace eosiosystem {
           * REX order couldn't be filled and is added to queue.
           * If account already has an open order, requested rex is added to existing order.
           */
-         auto oitr = _rexorders.find( from.value );
-         if ( oitr == _rexorders.end() ) {
-            oitr = _rexorders.emplace( from, [&]( auto& order ) {
+         auto oitr = _rexorders->find( from.value );
+         if ( oitr == _rexorders->end() ) {
+            oitr = _rexorders->emplace( from, [&]( auto& order ) {
                order.owner         = from;
                order.rex_requested = rex;
                order.is_open       = true;
@@ -129,7 +129,7 @@ namespace eosiosystem {
                order.order_time    = current_time_point();
             });
          } else {
-            _rexorders.modify( oitr, same_payer, [&]( auto& order ) {
+            _rexorders->modify( oitr, same_payer, [&]( auto& order ) {
                order.rex_requested.amount += rex.amount;
             });
          }
@@ -147,9 +147,9 @@ namespace eosiosystem {
    {
       require_auth( owner );
 
-      auto itr = _rexorders.require_find( owner.value, "no sellrex order is scheduled" );
+      auto itr = _rexorders->require_find( owner.value, "no sellrex order is scheduled" );
       check( itr->is_open, "sellrex order has been filled and cannot be canceled" );
-      _rexorders.erase( itr );
+      _rexorders->erase( itr );
    }
 
    void system_contract::rentcpu( const name& from, const name& receiver, const asset& loan_payment, const asset& loan_fund )
@@ -208,19 +208,19 @@ namespace eosiosystem {
 
       runrex(2);
 
-      auto itr = _rexbalance.require_find( owner.value, "account has no REX balance" );
+      auto itr = _rexbalance->require_find( owner.value, "account has no REX balance" );
       const asset init_stake = itr->vote_stake;
 
-      auto rexp_itr = _rexpool.begin();
-      const int64_t total_rex      = rexp_itr->total_rex.amount;
-      const int64_t total_lendable = rexp_itr->total_lendable.amount;
+      const auto& pool = get_rex_pool();
+      const int64_t total_rex      = pool.total_rex.amount;
+      const int64_t total_lendable = pool.total_lendable.amount;
       const int64_t rex_balance    = itr->rex_balance.amount;
 
       asset current_stake( 0, core_symbol() );
       if ( total_rex > 0 ) {
          current_stake.amount = ( uint128_t(rex_balance) * total_lendable ) / total_rex;
       }
-      _rexbalance.modify( itr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( itr, same_payer, [&]( auto& rb ) {
          rb.vote_stake = current_stake;
       });
 
@@ -235,9 +235,7 @@ namespace eosiosystem {
       check( balance.amount > 0, "balance must be set to have a positive amount" );
       check( balance.symbol == core_symbol(), "balance symbol must be core symbol" );
       check( rex_system_initialized(), "rex system is not initialized" );
-      _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& pool ) {
-         pool.total_rent = balance;
-      });
+      rex_pool_state().total_rent = balance;
    }
 
    void system_contract::rexexec( const name& user, uint16_t max )
@@ -253,7 +251,7 @@ namespace eosiosystem {
 
       runrex(2);
 
-      auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
+      auto bitr = _rexbalance->require_find( owner.value, "account has no REX balance" );
       asset rex_in_sell_order = update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
       consolidate_rex_balance( bitr, rex_in_sell_order );
    }
@@ -264,14 +262,14 @@ namespace eosiosystem {
 
       runrex(2);
 
-      auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
+      auto bitr = _rexbalance->require_find( owner.value, "account has no REX balance" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol, "asset must be a positive amount of (REX, 4)" );
       const asset   rex_in_sell_order = update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
       const int64_t rex_in_savings    = read_rex_savings( bitr );
       check( rex.amount + rex_in_sell_order.amount + rex_in_savings <= bitr->rex_balance.amount,
              "insufficient REX balance" );
       process_rex_maturities( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
          int64_t moved_rex = 0;
          while ( !rb.rex_maturities.empty() && moved_rex < rex.amount) {
             const int64_t drex = std::min( rex.amount - moved_rex, rb.rex_maturities.back().second );
@@ -298,12 +296,12 @@ namespace eosiosystem {
 
       runrex(2);
 
-      auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
+      auto bitr = _rexbalance->require_find( owner.value, "account has no REX balance" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol, "asset must be a positive amount of (REX, 4)" );
       const int64_t rex_in_savings = read_rex_savings( bitr );
       check( rex.amount <= rex_in_savings, "insufficient REX in savings" );
       process_rex_maturities( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
          const time_point_sec maturity = get_rex_maturity();
          if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == maturity ) {
             rb.rex_maturities.back().second += rex.amount;
@@ -334,20 +332,20 @@ namespace eosiosystem {
          auto net_idx = net_loans.get_index<"byowner"_n>();
          bool no_outstanding_net_loans = ( net_idx.find( owner.value ) == net_idx.end() );
 
-         auto fund_itr = _rexfunds.find( owner.value );
-         bool no_outstanding_rex_fund = ( fund_itr != _rexfunds.end() ) && ( fund_itr->balance.amount == 0 );
+         auto fund_itr = _rexfunds->find( owner.value );
+         bool no_outstanding_rex_fund = ( fund_itr != _rexfunds->end() ) && ( fund_itr->balance.amount == 0 );
 
          if ( no_outstanding_cpu_loans && no_outstanding_net_loans && no_outstanding_rex_fund ) {
-            _rexfunds.erase( fund_itr );
+            _rexfunds->erase( fund_itr );
          }
       }
 
       /// check for remaining rex balance
       {
-         auto rex_itr = _rexbalance.find( owner.value );
-         if ( rex_itr != _rexbalance.end() ) {
+         auto rex_itr = _rexbalance->find( owner.value );
+         if ( rex_itr != _rexbalance->end() ) {
             check( rex_itr->rex_balance.amount == 0, "account has remaining REX balance, must sell first");
-            _rexbalance.erase( rex_itr );
+            _rexbalance->erase( rex_itr );
          }
       }
    }
@@ -388,8 +386,8 @@ namespace eosiosystem {
          bool net_managed = false;
          bool cpu_managed = false;
 
-         auto voter_itr = _voters.find( receiver.value );
-         if( voter_itr != _voters.end() ) {
+         auto voter_itr = _voters->find( receiver.value );
+         if( voter_itr != _voters->end() ) {
             net_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::net_managed );
             cpu_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::cpu_managed );
          }
@@ -419,8 +417,8 @@ namespace eosiosystem {
     */
    void system_contract::check_voting_requirement( const name& owner, const char* error_msg )const
    {
-      auto vitr = _voters.find( owner.value );
-      check( vitr != _voters.end() && ( vitr->proxy || 21 <= vitr->producers.size() ), error_msg );
+      auto vitr = _voters->find( owner.value );
+      check( vitr != _voters->end() && ( vitr->proxy || 21 <= vitr->producers.size() ), error_msg );
    }
 
    /**
@@ -434,15 +432,47 @@ namespace eosiosystem {
       if ( !rex_available() ) {
          return false;
       } else {
-         if ( _rexorders.begin() == _rexorders.end() ) {
+         if ( _rexorders->begin() == _rexorders->end() ) {
             return true; // no outstanding sellrex orders
          } else {
-            auto idx = _rexorders.get_index<"bytime"_n>();
+            auto idx = _rexorders->get_index<"bytime"_n>();
             return !idx.begin()->is_open; // no outstanding unfilled sellrex orders
          }
       }
    }
 
+   /**
+    * @brief Returns the working copy of the rex_pool row
+    *
+    * The row is read once per action. Returned references stay valid and reflect changes made
+    * through rex_pool_state().
+    *
+    * @pre REX system is initialized
+    */
+   const rex_pool& system_contract::get_rex_pool()const
+   {
+      if ( !_rpool ) {
+         auto itr = _rexpool->begin();
+         check( itr != _rexpool->end(), "rex system not initialized yet" );
+         _rpool = *itr;
+      }
+      return *_rpool;
+   }
+
+   /**
+    * @brief Returns the working copy of the rex_pool row for modification
+    *
+    * Changes are written to the row once, when the action ends, instead of on every update.
+    *
+    * @pre REX system is initialized
+    */
+   rex_pool& system_contract::rex_pool_state()
+   {
+      get_rex_pool();
+      _rpool_modified = true;
+      return *_rpool;
+   }
+
    /**
     * @brief Updates rex_pool balances upon creating a new loan or renewing an existing one
     *
@@ -452,20 +482,19 @@ namespace eosiosystem {
     */
    void system_contract::add_loan_to_rex_pool( const asset& payment, int64_t rented_tokens, bool new_loan )
    {
-      _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rt ) {
-         // add payment to total_rent
-         rt.total_rent.amount    += payment.amount;
-         // move rented_tokens from total_unlent to total_lent
-         rt.total_unlent.amount  -= rented_tokens;
-         rt.total_lent.amount    += rented_tokens;
-         // add payment to total_unlent
-         rt.total_unlent.amount  += payment.amount;
-         rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
-         // increment loan_num if a new loan is being created
-         if ( new_loan ) {
-            rt.loan_num++;
-         }
-      });
+      auto& rt = rex_pool_state();
+      // add payment to total_rent
+      rt.total_rent.amount    += payment.amount;
+      // move rented_tokens from total_unlent to total_lent
+      rt.total_unlent.amount  -= rented_tokens;
+      rt.total_lent.amount    += rented_tokens;
+      // add payment to total_unlent
+      rt.total_unlent.amount  += payment.amount;
+      rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
+      // increment loan_num if a new loan is being created
+      if ( new_loan ) {
+         rt.loan_num++;
+      }
    }
 
    /**
@@ -475,18 +504,16 @@ namespace eosiosystem {
     */
    void system_contract::remove_loan_from_rex_pool( const rex_loan& loan )
    {
-      const auto& pool = _rexpool.begin();
-      const int64_t delta_total_rent = exchange_state::get_bancor_output( pool->total_unlent.amount,
-                                                                          pool->total_rent.amount,
+      auto& rt = rex_pool_state();
+      const int64_t delta_total_rent = exchange_state::get_bancor_output( rt.total_unlent.amount,
+                                                                          rt.total_rent.amount,
                                                                           loan.total_staked.amount );
-      _rexpool.modify( pool, same_payer, [&]( auto& rt ) {
-         // deduct calculated delta_total_rent from total_rent
-         rt.total_rent.amount    -= delta_total_rent;
-         // move rented tokens from total_lent to total_unlent
-         rt.total_unlent.amount  += loan.total_staked.amount;
-         rt.total_lent.amount    -= loan.total_staked.amount;
-         rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
-      });
+      // deduct calculated delta_total_rent from total_rent
+      rt.total_rent.amount    -= delta_total_rent;
+      // move rented tokens from total_lent to total_unlent
+      rt.total_unlent.amount  += loan.total_staked.amount;
+      rt.total_lent.amount    -= loan.total_staked.amount;
+      rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
    }
 
    /**
@@ -513,7 +540,8 @@ namespace eosiosystem {
    {
       check( rex_system_initialized(), "rex system not initialized yet" );
 
-      const auto& pool = _rexpool.begin();
+      /// working copy, reflects the changes made while processing loans and orders
+      const auto& pool = get_rex_pool();
 
       auto process_expired_loan = [&]( auto& idx, const auto& itr ) -> std::pair<bool, int64_t> {
          /// update rex_pool in order to delete existing loan
@@ -521,8 +549,8 @@ namespace eosiosystem {
          bool    delete_loan   = false;
          int64_t delta_stake   = 0;
          /// calculate rented tokens at current price
-         int64_t rented_tokens = exchange_state::get_bancor_output( pool->total_rent.amount,
-                                                                    pool->total_unlent.amount,
+         int64_t rented_tokens = exchange_state::get_bancor_output( pool.total_rent.amount,
+                                                                    pool.total_unlent.amount,
                                                                     itr->payment.amount );
          /// conditions for loan renewal
          bool renew_loan = itr->payment <= itr->balance        /// loan has sufficient balance
@@ -580,15 +608,15 @@ namespace eosiosystem {
       }
 
       /// process sellrex orders
-      if ( _rexorders.begin() != _rexorders.end() ) {
-         auto idx  = _rexorders.get_index<"bytime"_n>();
+      if ( _rexorders->begin() != _rexorders->end() ) {
+         auto idx  = _rexorders->get_index<"bytime"_n>();
          auto oitr = idx.begin();
          for ( uint16_t i = 0; i < max; ++i ) {
             if ( oitr == idx.end() || !oitr->is_open ) break;
             auto next = oitr;
             ++next;
-            auto bitr = _rexbalance.find( oitr->owner.value );
-            if ( bitr != _rexbalance.end() ) { // should always be true
+            auto bitr = _rexbalance->find( oitr->owner.value );
+            if ( bitr != _rexbalance->end() ) { // should always be true
                auto result = fill_rex_order( bitr, oitr->rex_requested );
                if ( result.success ) {
                   const name order_owner = oitr->owner;
@@ -619,10 +647,10 @@ namespace eosiosystem {
 
       transfer_from_fund( from, payment + fund );
 
-      const auto& pool = _rexpool.begin(); /// already checked that _rexpool.begin() != _rexpool.end() in rex_loans_available()
+      const auto& pool = get_rex_pool(); /// already checked that the pool exists in rex_loans_available()
 
-      int64_t rented_tokens = exchange_state::get_bancor_output( pool->total_rent.amount,
-                                                                 pool->total_unlent.amount,
+      int64_t rented_tokens = exchange_state::get_bancor_output( pool.total_rent.amount,
+                                                                 pool.total_unlent.amount,
                                                                  payment.amount );
       check( payment.amount < rented_tokens, "loan price does not favor renting" );
       add_loan_to_rex_pool( payment, rented_tokens, true );
@@ -634,7 +662,7 @@ namespace eosiosystem {
          c.balance      = fund;
          c.total_staked = asset( rented_tokens, core_symbol() );
          c.expiration   = current_time_point() + eosio::days(30);
-         c.loan_num     = pool->loan_num;
+         c.loan_num     = pool.loan_num;
       });
 
       rex_results::rentresult_action rentresult_act{ rex_account, std::vector<eosio::permission_level>{ } };
@@ -660,9 +688,9 @@ namespace eosiosystem {
     */
    rex_order_outcome system_contract::fill_rex_order( const rex_balance_table::const_iterator& bitr, const asset& rex )
    {
-      auto rexitr = _rexpool.begin();
-      const int64_t S0 = rexitr->total_lendable.amount;
-      const int64_t R0 = rexitr->total_rex.amount;
+      const auto& pool = get_rex_pool();
+      const int64_t S0 = pool.total_lendable.amount;
+      const int64_t R0 = pool.total_rex.amount;
       const int64_t p  = (uint128_t(rex.amount) * S0) / R0;
       const int64_t R1 = R0 - rex.amount;
       const int64_t S1 = S0 - p;
@@ -670,17 +698,16 @@ namespace eosiosystem {
       asset stake_change( 0, core_symbol() );
       bool  success = false;
 
-      const int64_t unlent_lower_bound = ( uint128_t(2) * rexitr->total_lent.amount ) / 10;
-      const int64_t available_unlent   = rexitr->total_unlent.amount - unlent_lower_bound; // available_unlent <= 0 is possible
+      const int64_t unlent_lower_bound = ( uint128_t(2) * pool.total_lent.amount ) / 10;
+      const int64_t available_unlent   = pool.total_unlent.amount - unlent_lower_bound; // available_unlent <= 0 is possible
       if ( proceeds.amount <= available_unlent ) {
          const int64_t init_vote_stake_amount = bitr->vote_stake.amount;
          const int64_t current_stake_value    = ( uint128_t(bitr->rex_balance.amount) * S0 ) / R0;
-         _rexpool.modify( rexitr, same_payer, [&]( auto& rt ) {
-            rt.total_rex.amount      = R1;
-            rt.total_lendable.amount = S1;
-            rt.total_unlent.amount   = rt.total_lendable.amount - rt.total_lent.amount;
-         });
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+         auto& rt = rex_pool_state();
+         rt.total_rex.amount      = R1;
+         rt.total_lendable.amount = S1;
+         rt.total_unlent.amount   = rt.total_lendable.amount - rt.total_lent.amount;
+         _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
             rb.vote_stake.amount   = current_stake_value - proceeds.amount;
             rb.rex_balance.amount -= rex.amount;
             rb.matured_rex        -= rex.amount;
@@ -732,9 +759,9 @@ namespace eosiosystem {
    void system_contract::transfer_from_fund( const name& owner, const asset& amount )
    {
       check( 0 < amount.amount && amount.symbol == core_symbol(), "must transfer positive amount from REX fund" );
-      auto itr = _rexfunds.require_find( owner.value, "must deposit to REX fund first" );
+      auto itr = _rexfunds->require_find( owner.value, "must deposit to REX fund first" );
       check( amount <= itr->balance, "insufficient funds" );
-      _rexfunds.modify( itr, same_payer, [&]( auto& fund ) {
+      _rexfunds->modify( itr, same_payer, [&]( auto& fund ) {
          fund.balance.amount -= amount.amount;
       });
    }
@@ -748,14 +775,14 @@ namespace eosiosystem {
    void system_contract::transfer_to_fund( const name& owner, const asset& amount )
    {
       check( 0 < amount.amount && amount.symbol == core_symbol(), "must transfer positive amount to REX fund" );
-      auto itr = _rexfunds.find( owner.value );
-      if ( itr == _rexfunds.end() ) {
-         _rexfunds.emplace( owner, [&]( auto& fund ) {
+      auto itr = _rexfunds->find( owner.value );
+      if ( itr == _rexfunds->end() ) {
+         _rexfunds->emplace( owner, [&]( auto& fund ) {
             fund.owner   = owner;
             fund.balance = amount;
          });
       } else {
-         _rexfunds.modify( itr, same_payer, [&]( auto& fund ) {
+         _rexfunds->modify( itr, same_payer, [&]( auto& fund ) {
             fund.balance.amount += amount.amount;
          });
       }
@@ -781,14 +808,14 @@ namespace eosiosystem {
       asset to_fund( proceeds );
       asset to_stake( delta_stake );
       asset rex_in_sell_order( 0, rex_symbol );
-      auto itr = _rexorders.find( owner.value );
-      if ( itr != _rexorders.end() ) {
+      auto itr = _rexorders->find( owner.value );
+      if ( itr != _rexorders->end() ) {
          if ( itr->is_open ) {
             rex_in_sell_order.amount = itr->rex_requested.amount;
          } else {
             to_fund.amount  += itr->proceeds.amount;
             to_stake.amount += itr->stake_change.amount;
-            _rexorders.erase( itr );
+            _rexorders->erase( itr );
          }
       }
 
@@ -810,10 +837,9 @@ namespace eosiosystem {
    {
 #if CHANNEL_RAM_AND_NAMEBID_FEES_TO_REX
       if ( rex_available() ) {
-         _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rp ) {
-            rp.total_unlent.amount   += amount.amount;
-            rp.total_lendable.amount += amount.amount;
-         });
+         auto& rp = rex_pool_state();
+         rp.total_unlent.amount   += amount.amount;
+         rp.total_lendable.amount += amount.amount;
          // inline transfer to rex_account
          token::transfer_action transfer_act{ token_account, { from, active_permission } };
          transfer_act.send( from, rex_account, amount,
@@ -831,9 +857,7 @@ namespace eosiosystem {
    {
 #if CHANNEL_RAM_AND_NAMEBID_FEES_TO_REX
       if ( rex_available() ) {
-         _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rp ) {
-            rp.namebid_proceeds.amount += highest_bid;
-         });
+         rex_pool_state().namebid_proceeds.amount += highest_bid;
       }
 #endif
    }
@@ -861,7 +885,7 @@ namespace eosiosystem {
    void system_contract::process_rex_maturities( const rex_balance_table::const_iterator& bitr )
    {
       const time_point_sec now = current_time_point();
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
          while ( !rb.rex_maturities.empty() && rb.rex_maturities.front().first <= now ) {
             rb.matured_rex += rb.rex_maturities.front().second;
             rb.rex_maturities.pop_front();
@@ -879,7 +903,7 @@ namespace eosiosystem {
                                                   const asset& rex_in_sell_order )
    {
       const int64_t rex_in_savings = read_rex_savings( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
          int64_t total  = rb.matured_rex - rex_in_sell_order.amount;
          rb.matured_rex = rex_in_sell_order.amount;
          while ( !rb.rex_maturities.empty() ) {
@@ -913,10 +937,9 @@ namespace eosiosystem {
       const int64_t rex_ratio = 10000;
       const asset   init_total_rent( 20'000'0000, core_symbol() ); /// base balance prevents renting profitably until at least a minimum number of core_symbol() is made available
       asset rex_received( 0, rex_symbol );
-      auto itr = _rexpool.begin();
       if ( !rex_system_initialized() ) {
          /// initialize REX pool
-         _rexpool.emplace( get_self(), [&]( auto& rp ) {
+         _rexpool->emplace( get_self(), [&]( auto& rp ) {
             rex_received.amount = payment.amount * rex_ratio;
             rp.total_lendable   = payment;
             rp.total_lent       = asset( 0, core_symbol() );
@@ -926,28 +949,26 @@ namespace eosiosystem {
             rp.namebid_proceeds = asset( 0, core_symbol() );
          });
       } else if ( !rex_available() ) { /// should be a rare corner case, REX pool is initialized but empty
-         _rexpool.modify( itr, same_payer, [&]( auto& rp ) {
-            rex_received.amount      = payment.amount * rex_ratio;
-            rp.total_lendable.amount = payment.amount;
-            rp.total_lent.amount     = 0;
-            rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
-            rp.total_rent.amount     = init_total_rent.amount;
-            rp.total_rex.amount      = rex_received.amount;
-         });
+         auto& rp = rex_pool_state();
+         rex_received.amount      = payment.amount * rex_ratio;
+         rp.total_lendable.amount = payment.amount;
+         rp.total_lent.amount     = 0;
+         rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
+         rp.total_rent.amount     = init_total_rent.amount;
+         rp.total_rex.amount      = rex_received.amount;
       } else {
          /// total_lendable > 0 if total_rex > 0 except in a rare case and due to rounding errors
-         check( itr->total_lendable.amount > 0, "lendable REX pool is empty" );
-         const int64_t S0 = itr->total_lendable.amount;
+         auto& rp = rex_pool_state();
+         check( rp.total_lendable.amount > 0, "lendable REX pool is empty" );
+         const int64_t S0 = rp.total_lendable.amount;
          const int64_t S1 = S0 + payment.amount;
-         const int64_t R0 = itr->total_rex.amount;
+         const int64_t R0 = rp.total_rex.amount;
          const int64_t R1 = (uint128_t(S1) * R0) / S0;
          rex_received.amount = R1 - R0;
-         _rexpool.modify( itr, same_payer, [&]( auto& rp ) {
-            rp.total_lendable.amount = S1;
-            rp.total_rex.amount      = R1;
-            rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
-            check( rp.total_unlent.amount >= 0, "programmer error, this should never go negative" );
-         });
+         rp.total_lendable.amount = S1;
+         rp.total_rex.amount      = R1;
+         rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
+         check( rp.total_unlent.amount >= 0, "programmer error, this should never go negative" );
       }
 
       return rex_received;
@@ -966,9 +987,9 @@ namespace eosiosystem {
    {
       asset init_rex_stake( 0, core_symbol() );
       asset current_rex_stake( 0, core_symbol() );
-      auto bitr = _rexbalance.find( owner.value );
-      if ( bitr == _rexbalance.end() ) {
-         bitr = _rexbalance.emplace( owner, [&]( auto& rb ) {
+      auto bitr = _rexbalance->find( owner.value );
+      if ( bitr == _rexbalance->end() ) {
+         bitr = _rexbalance->emplace( owner, [&]( auto& rb ) {
             rb.owner       = owner;
             rb.vote_stake  = payment;
             rb.rex_balance = rex_received;
@@ -976,17 +997,17 @@ namespace eosiosystem {
          current_rex_stake.amount = payment.amount;
       } else {
          init_rex_stake.amount = bitr->vote_stake.amount;
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+         _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
             rb.rex_balance.amount += rex_received.amount;
-            rb.vote_stake.amount   = ( uint128_t(rb.rex_balance.amount) * _rexpool.begin()->total_lendable.amount )
-                                     / _rexpool.begin()->total_rex.amount;
+            rb.vote_stake.amount   = ( uint128_t(rb.rex_balance.amount) * get_rex_pool().total_lendable.amount )
+                                     / get_rex_pool().total_rex.amount;
          });
          current_rex_stake.amount = bitr->vote_stake.amount;
       }
 
       const int64_t rex_in_savings = read_rex_savings( bitr );
       process_rex_maturities( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
          const time_point_sec maturity = get_rex_maturity();
          if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == maturity ) {
             rb.rex_maturities.back().second += rex_received.amount;
@@ -1014,7 +1035,7 @@ namespace eosiosystem {
       int64_t rex_in_savings = 0;
       static const time_point_sec end_of_days = time_point_sec::maximum();
       if ( !bitr->rex_maturities.empty() && bitr->rex_maturities.back().first == end_of_days ) {
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+         _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
             rex_in_savings = rb.rex_maturities.back().second;
             rb.rex_maturities.pop_back();
          });
@@ -1032,7 +1053,7 @@ namespace eosiosystem {
    {
       if ( rex == 0 ) return;
       static const time_point_sec end_of_days = time_point_sec::maximum();
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+      _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
          if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == end_of_days ) {
             rb.rex_maturities.back().second += rex;
          } else {
@@ -1049,22 +1070,22 @@ namespace eosiosystem {
    void system_contract::update_rex_stake( const name& voter )
    {
       int64_t delta_stake = 0;
-      auto bitr = _rexbalance.find( voter.value );
-      if ( bitr != _rexbalance.end() && rex_available() ) {
+      auto bitr = _rexbalance->find( voter.value );
+      if ( bitr != _rexbalance->end() && rex_available() ) {
          asset init_vote_stake = bitr->vote_stake;
          asset current_vote_stake( 0, core_symbol() );
-         current_vote_stake.amount = ( uint128_t(bitr->rex_balance.amount) * _rexpool.begin()->total_lendable.amount )
-                                     / _rexpool.begin()->total_rex.amount;
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+         current_vote_stake.amount = ( uint128_t(bitr->rex_balance.amount) * get_rex_pool().total_lendable.amount )
+                                     / get_rex_pool().total_rex.amount;
+         _rexbalance->modify( bitr, same_payer, [&]( auto& rb ) {
             rb.vote_stake.amount = current_vote_stake.amount;
          });
          delta_stake = current_vote_stake.amount - init_vote_stake.amount;
       }
 
       if ( delta_stake != 0 ) {
-         auto vitr = _voters.find( voter.value );
-         if ( vitr != _voters.end() ) {
-            _voters.modify( vitr, same_payer, [&]( auto& vinfo ) {
+         auto vitr = _voters->find( voter.value );
+         if ( vitr != _voters->end() ) {
+            _voters->modify( vitr, same_payer, [&]( auto& vinfo ) {
                vinfo.staked += delta_stake;
             });
          }
@@ -8,4 +8,10 @@ void rex_results::orderresult( const name& owner, const asset& proceeds ) { }
 
 void rex_results::rentresult( const asset& rented_tokens ) { }
 
+void rex_results::ramresult( const name& owner, int64_t bytes, const asset& tokens, const asset& total_ram_refund ) { }
+
+void rex_results::delramresult( const name& from, const name& receiver, int64_t bytes, const asset& stake ) { }
+
+void rex_results::claimresult( const name& owner, const asset& earned_pay ) { }
+
 extern "C" void apply( uint64_t, uint64_t, uint64_t ) { }
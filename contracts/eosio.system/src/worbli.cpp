@@ -1,3 +1,4 @@
+#include <eosio.system/rex.results.hpp>
 #include <eosio.system/worbli.prov.common.hpp>
 #include <cmath>
 
@@ -12,7 +13,7 @@ namespace eosiosystem {
 
       const asset token_supply   = eosio::token::get_supply(token_account, core_symbol().code() );
       const uint64_t token_precision = token_supply.symbol.precision();
-      const uint64_t bytes_per_token = uint64_t((_gstate.max_ram_size / (double)token_supply.amount) * pow(10,token_precision));
+      const uint64_t bytes_per_token = uint64_t((global_hot().max_ram_size / (double)token_supply.amount) * pow(10,token_precision));
       auto amount = int64_t((bytes * pow(10,token_precision)) / bytes_per_token);
 
       require_auth( from );
@@ -67,6 +68,11 @@ namespace eosiosystem {
          }
       } // tot_itr can be invalid, should go out of scope
 
+#if SYSTEM_ENABLE_REX
+      // dummy action added so that the delegated bytes and stake show up in action trace
+      rex_results::delramresult_action delramresult_act{ rex_account, std::vector<eosio::permission_level>{ } };
+      delramresult_act.send( from, receiver, bytes, asset(amount, core_symbol()) );
+#endif
    } // delegateram
 
    void system_contract::regproducer( const name& producer, const eosio::public_key& producer_key, const std::string& url, uint16_t location ) {
@@ -74,12 +80,12 @@ namespace eosiosystem {
       check( producer_key != eosio::public_key(), "public key should not be the default value" );
       require_auth( producer );
 
-      auto prod = _producers.find( producer.value );
-      check( prod != _producers.end(), "account is not registered as a producer" );
+      auto prod = _producers->find( producer.value );
+      check( prod != _producers->end(), "account is not registered as a producer" );
       check( prod->active(), "account is not an active producer" );
 
-      if ( prod != _producers.end() ) {
-         _producers.modify( prod, producer, [&]( producer_info& info ){
+      if ( prod != _producers->end() ) {
+         _producers->modify( prod, producer, [&]( producer_info& info ){
             info.producer_key = producer_key;
             info.url          = url;
             info.location     = location;
@@ -90,19 +96,19 @@ namespace eosiosystem {
    void system_contract::unregprod( const name& producer ) {
       require_auth( producer );
 
-      const auto& prod = _producers.get( producer.value, "producer not found" );
-      _producers.modify( prod, same_payer, [&]( producer_info& info ){
+      const auto& prod = _producers->get( producer.value, "producer not found" );
+      _producers->modify( prod, same_payer, [&]( producer_info& info ){
          info.producer_key = eosio::public_key();
          info.unpaid_blocks = 0;
       });
    }
 
    void system_contract::update_elected_producers( const block_timestamp& block_time ) {
-      _gstate.last_producer_schedule_update = block_time;
+      global_hot().last_producer_schedule_update = block_time;
 
       std::vector< std::pair<eosio::producer_key,uint16_t> > top_producers;
 
-      for( const auto& p : _producers ) {
+      for( const auto& p : *_producers ) {
         if( p.producer_key != eosio::public_key() )
             top_producers.emplace_back( std::pair<eosio::producer_key,uint16_t>({{p.owner, p.producer_key}, p.location}) );
       }
@@ -116,7 +122,7 @@ namespace eosiosystem {
          producers.push_back(item.first);
 
       if( set_proposed_producers( producers ) >= 0 ) {
-         _gstate.last_producer_schedule_size = static_cast<decltype(_gstate.last_producer_schedule_size)>( top_producers.size() );
+         global_hot().last_producer_schedule_size = static_cast<decltype(global_hot().last_producer_schedule_size)>( top_producers.size() );
       }
    }
 
@@ -134,11 +140,11 @@ namespace eosiosystem {
       check( producer != "eosio"_n, "producer should not be eosio" );
       require_auth( "worbli.admin"_n );
 
-      auto prod = _producers.find( producer.value );
+      auto prod = _producers->find( producer.value );
 
-      check( prod == _producers.end(), "account already registered as a producer" );
+      check( prod == _producers->end(), "account already registered as a producer" );
 
-      _producers.emplace( producer, [&]( producer_info& info ){
+      _producers->emplace( producer, [&]( producer_info& info ){
             info.owner         = producer;
             info.is_active     = false;
       });
@@ -153,10 +159,10 @@ namespace eosiosystem {
    void system_contract::promoteprod( const name producer ) {
       require_auth( "worbli.admin"_n );
 
-      auto prod = _producers.find( producer.value );
-      check( prod != _producers.end(), "producer has not been registered yet" );
+      auto prod = _producers->find( producer.value );
+      check( prod != _producers->end(), "producer has not been registered yet" );
 
-      _producers.modify( prod, same_payer, [&]( auto& p ) {
+      _producers->modify( prod, same_payer, [&]( auto& p ) {
          p.is_active     = true;
       });
    }
@@ -170,10 +176,10 @@ namespace eosiosystem {
    void system_contract::demoteprod( const name producer ) {
       require_auth( "worbli.admin"_n );
 
-      auto prod = _producers.find( producer.value );
-      check( prod != _producers.end(), "producer has not been registered yet" );
+      auto prod = _producers->find( producer.value );
+      check( prod != _producers->end(), "producer has not been registered yet" );
 
-      _producers.modify( prod, same_payer, [&]( auto& p ) {
+      _producers->modify( prod, same_payer, [&]( auto& p ) {
             p.deactivate();
             p.unpaid_blocks = 0;
       });
@@ -188,26 +194,35 @@ namespace eosiosystem {
     */
    void system_contract::togglesched( bool is_active ) {
       require_auth( _self );
-      _gstate.is_producer_schedule_active = is_active;
+      global_hot().is_producer_schedule_active = is_active;
 
    }
 
    void system_contract::setusagelvl( uint8_t new_level ) {
       require_auth( "worbli.admin"_n );
 
-      check( _gstate.network_usage_level < new_level, "usage level may only be increased" ); 
+      check( global_hot().network_usage_level < new_level, "usage level may only be increased" ); 
       check( new_level <= 100, "usage level cannot excced 100" );
       check( new_level > 0, "usage level cannot be negative" );
 
-      _gstate.network_usage_level = new_level;
-      _global.set( _gstate, _self );
+      global_hot().network_usage_level = new_level;
    }
 
     void system_contract::setwparams(uint64_t max_subaccounts) {
       require_auth( "worbli.admin"_n );
-      _wstate.max_subaccounts = max_subaccounts;
+      worbli_state().max_subaccounts = max_subaccounts;
     }
 
+   void system_contract::setinflation( uint32_t numerator, uint32_t denominator ) {
+      require_auth( "worbli.admin"_n );
+
+      check( denominator > 0, "denominator must be positive" );
+      check( numerator < denominator, "inflation rate must be below 100%" );
+
+      worbli_state().inflation_numerator.emplace( numerator );
+      worbli_state().inflation_denominator.emplace( denominator );
+   }
+
    // worbli additions
     void native::can_create_subaccount(name creator) {
 
@@ -216,6 +231,8 @@ namespace eosiosystem {
         // no validation if worbli.prov account does not exist.
         if(!is_account(provider_account)) return;
 
+        WORBLI_PROFILE_SECTION( "identity check" );
+
          // TODO: make condition name an enum
          // TODO: add optional comparator to condition >, <, = etc...
          std::vector<worblisystem::condition> conditions {
@@ -232,10 +249,15 @@ namespace eosiosystem {
          int64_t max_subaccounts = opt ? *opt : 0;
 
         worbli_params_singleton worbliparams(_self, _self.value);
-        worbli_params wstate = worbliparams.exists() ? worbliparams.get() : worbli_params{0};
+        const bool has_params = worbliparams.exists();
+        worbli_params wstate = has_params ? worbliparams.get() : worbli_params{0};
+        /// exists() and, when there is a row, get()
+        WORBLI_PROFILE_READS( has_params ? 2 : 1 );
 
         subaccount_table subaccounts(_self, creator.value);
         auto sub_count = std::distance(subaccounts.cbegin(),subaccounts.cend());
+        /// the lookup of the first row and one step past each row
+        WORBLI_PROFILE_READS( sub_count + 1 );
 
         max_subaccounts = max_subaccounts < 0 ? wstate.max_subaccounts : max_subaccounts;
         check( max_subaccounts > sub_count, "subaccount limit reached" );
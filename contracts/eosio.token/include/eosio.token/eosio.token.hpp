@@ -1,6 +1,7 @@
 #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/eosio.hpp>
 
 #include <string>
@@ -27,6 +28,15 @@ namespace eosio {
       public:
          using contract::contract;
 
+         /**
+          * One recipient of the transfers action.
+          */
+         struct payment {
+            name     to;
+            asset    quantity;
+            string   memo;
+         };
+
          /**
           * Create action.
           *
@@ -56,6 +66,22 @@ namespace eosio {
          [[eosio::action]]
          void issue( const name& to, const asset& quantity, const string& memo );
 
+         /**
+          * Issue many action.
+          *
+          * @details Issues new tokens directly to several accounts. Equivalent to an `issue` of the
+          * total to the issuer followed by a `transfer` to every recipient, but the token statistics
+          * are updated once and the issuer's balance is not touched. All payments must be of the same
+          * token, every recipient is notified of the `issuemany` action only. No `transfer` is sent,
+          * so contracts that only listen to `transfer` will not see these tokens.
+          *
+          * @param payments - the recipients, quantities and memos of the issued tokens.
+          *
+          * @pre Requires authorization of the token issuer.
+          */
+         [[eosio::action]]
+         void issuemany( const std::vector<payment>& payments );
+
          /**
           * Retire action.
           *
@@ -84,6 +110,21 @@ namespace eosio {
                         const name&    to,
                         const asset&   quantity,
                         const string&  memo );
+
+         /**
+          * Transfers action.
+          *
+          * @details Allows `from` account to transfer tokens to several accounts at once. The token
+          * statistics are read once and `from` is debited once with the sum of all payments, then
+          * every recipient is credited. All payments must be of the same token. `from` and every
+          * recipient are notified of the `transfers` action, contracts that only listen to `transfer`
+          * will not see these payments.
+          *
+          * @param from - the account to transfer from,
+          * @param payments - the recipients, quantities and memos of the individual payments.
+          */
+         [[eosio::action]]
+         void transfers( const name& from, const std::vector<payment>& payments );
          /**
           * Open action.
           *
@@ -115,6 +156,42 @@ namespace eosio {
          [[eosio::action]]
          void close( const name& owner, const symbol& symbol );
 
+         /**
+          * Enable checkpoints action.
+          *
+          * @details Starts recording historical balances of token `sym`. From now on the first change
+          * of every balance within an epoch appends the balance it had before the change to the
+          * `checkpoints` table of the owner, so the balance at the end of any of the last
+          * `checkpoint_retention` epochs can be looked up with `get_balance_at`. Checkpoints cannot be
+          * disabled again once enabled.
+          *
+          * A checkpoint is billed like the balance it records: to the owner when the owner authorized
+          * the change, otherwise to the sender of the tokens. Writing a checkpoint erases the owner's
+          * checkpoints of the token that fell out of the retention window, so an owner never holds more
+          * than `checkpoint_retention` of them per token and their RAM goes back to whoever paid for it.
+          *
+          * @param sym - the token to record historical balances for.
+          *
+          * @pre Requires authorization of the token issuer.
+          */
+         [[eosio::action]]
+         void enableckpt( const symbol_code& sym );
+
+         /**
+          * New epoch action.
+          *
+          * @details Closes the current checkpoint epoch of token `sym` and starts the next one.
+          * Balances as of the end of the closed epoch stay available through `get_balance_at` for
+          * the next `checkpoint_retention` epochs.
+          *
+          * @param sym - the token to advance the epoch for.
+          *
+          * @pre Requires authorization of the token issuer,
+          * @pre Checkpoints have to be enabled for `sym`.
+          */
+         [[eosio::action]]
+         void newepoch( const symbol_code& sym );
+
          /**
           * Get supply method.
           *
@@ -147,12 +224,55 @@ namespace eosio {
             return ac.balance;
          }
 
+         /**
+          * Get balance at epoch method.
+          *
+          * @details Get the balance of `owner` for token `sym_code` as of the end of checkpoint epoch
+          * `epoch`. Only meaningful for epochs after checkpoints were enabled for the token, and fails
+          * for epochs that fell out of the retention window.
+          *
+          * @param token_contract_account - the token creator account,
+          * @param owner - the account for which the token balance is returned,
+          * @param sym_code - the token for which the balance is returned,
+          * @param epoch - the checkpoint epoch.
+          */
+         static asset get_balance_at( const name& token_contract_account, const name& owner, const symbol_code& sym_code,
+                                      uint32_t epoch )
+         {
+            stats statstable( token_contract_account, sym_code.raw() );
+            const auto& st = statstable.get( sym_code.raw() );
+            check( st.checkpoint_epoch.has_value(), "checkpoints not enabled" );
+            check( uint64_t(epoch) + checkpoint_retention >= st.checkpoint_epoch.value(), "checkpoint epoch no longer retained" );
+
+            // the first checkpoint after `epoch` holds the balance before any later change
+            checkpoints ckpts( token_contract_account, owner.value );
+            auto idx = ckpts.get_index<"bysymepoch"_n>();
+            auto itr = idx.lower_bound( checkpoint::key( sym_code, uint64_t(epoch) + 1 ) );
+            if( itr != idx.end() && itr->balance.symbol.code() == sym_code ) {
+               return itr->balance;
+            }
+
+            accounts accountstable( token_contract_account, owner.value );
+            auto ac = accountstable.find( sym_code.raw() );
+            if( ac != accountstable.end() ) {
+               return ac->balance;
+            }
+            return asset( 0, st.supply.symbol );
+         }
+
+         /// number of closed epochs whose balances are kept
+         static constexpr uint32_t checkpoint_retention = 32;
+
          using create_action = eosio::action_wrapper<"create"_n, &token::create>;
          using issue_action = eosio::action_wrapper<"issue"_n, &token::issue>;
+         using issuemany_action = eosio::action_wrapper<"issuemany"_n, &token::issuemany>;
          using retire_action = eosio::action_wrapper<"retire"_n, &token::retire>;
          using transfer_action = eosio::action_wrapper<"transfer"_n, &token::transfer>;
+         using transfers_action = eosio::action_wrapper<"transfers"_n, &token::transfers>;
          using open_action = eosio::action_wrapper<"open"_n, &token::open>;
          using close_action = eosio::action_wrapper<"close"_n, &token::close>;
+         using enableckpt_action = eosio::action_wrapper<"enableckpt"_n, &token::enableckpt>;
+         using newepoch_action = eosio::action_wrapper<"newepoch"_n, &token::newepoch>;
       private:
          struct [[eosio::table]] account {
             asset    balance;
@@ -164,15 +284,35 @@ namespace eosio {
             asset    supply;
             asset    max_supply;
             name     issuer;
+            //current checkpoint epoch, present once checkpoints are enabled for the token
+            eosio::binary_extension<uint32_t> checkpoint_epoch;
 
             uint64_t primary_key()const { return supply.symbol.code().raw(); }
          };
 
+         // balance of the owner at the start of `epoch`, recorded on its first change in that epoch
+         struct [[eosio::table]] checkpoint {
+            uint64_t    id;
+            uint32_t    epoch;
+            asset       balance;
+
+            uint64_t  primary_key()const { return id; }
+            uint128_t by_symbol_epoch()const { return key( balance.symbol.code(), epoch ); }
+
+            static uint128_t key( const symbol_code& sym, uint64_t epoch ) {
+               return ( uint128_t( sym.raw() ) << 64 ) | epoch;
+            }
+         };
+
          typedef eosio::multi_index< "accounts"_n, account > accounts;
          typedef eosio::multi_index< "stat"_n, currency_stats > stats;
+         typedef eosio::multi_index< "checkpoints"_n, checkpoint,
+                                     indexed_by<"bysymepoch"_n, const_mem_fun<checkpoint, uint128_t, &checkpoint::by_symbol_epoch>>
+                                   > checkpoints;
 
-         void sub_balance( const name& owner, const asset& value );
-         void add_balance( const name& owner, const asset& value, const name& ram_payer );
+         void sub_balance( const name& owner, const asset& value, const currency_stats& st );
+         void add_balance( const name& owner, const asset& value, const name& ram_payer, const currency_stats& st );
+         void checkpoint_balance( const name& owner, const asset& balance, const name& ram_payer, const currency_stats& st );
    };
    /** @}*/ // end of @defgroup eosiotoken eosio.token
 } /// namespace eosio
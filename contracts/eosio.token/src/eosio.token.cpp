@@ -47,7 +47,43 @@ void token::issue( const name& to, const asset& quantity, const string& memo )
        s.supply += quantity;
     });
 
-    add_balance( st.issuer, quantity, st.issuer );
+    add_balance( st.issuer, quantity, st.issuer, st );
+}
+
+void token::issuemany( const std::vector<payment>& payments )
+{
+    check( !payments.empty(), "no payments to issue" );
+    auto sym = payments.front().quantity.symbol;
+    check( sym.is_valid(), "invalid symbol name" );
+
+    stats statstable( get_self(), sym.code().raw() );
+    auto existing = statstable.find( sym.code().raw() );
+    check( existing != statstable.end(), "token with symbol does not exist, create token before issue" );
+    const auto& st = *existing;
+
+    require_auth( st.issuer );
+    check( sym == st.supply.symbol, "symbol precision mismatch" );
+
+    asset total( 0, sym );
+    for( const auto& p : payments ) {
+        check( is_account( p.to ), "to account does not exist");
+        check( p.quantity.is_valid(), "invalid quantity" );
+        check( p.quantity.amount > 0, "must issue positive quantity" );
+        check( p.quantity.symbol == sym, "symbol precision mismatch" );
+        check( p.memo.size() <= 256, "memo has more than 256 bytes" );
+
+        require_recipient( p.to );
+        total += p.quantity;
+    }
+    check( total.amount <= st.max_supply.amount - st.supply.amount, "quantity exceeds available supply");
+
+    statstable.modify( st, same_payer, [&]( auto& s ) {
+       s.supply += total;
+    });
+
+    for( const auto& p : payments ) {
+        add_balance( p.to, p.quantity, st.issuer, st );
+    }
 }
 
 void token::retire( const asset& quantity, const string& memo )
@@ -71,7 +107,7 @@ void token::retire( const asset& quantity, const string& memo )
        s.supply -= quantity;
     });
 
-    sub_balance( st.issuer, quantity );
+    sub_balance( st.issuer, quantity, st );
 }
 
 void token::transfer( const name&    from,
@@ -96,36 +132,100 @@ void token::transfer( const name&    from,
 
     auto payer = has_auth( to ) ? to : from;
 
-    sub_balance( from, quantity );
-    add_balance( to, quantity, payer );
+    sub_balance( from, quantity, st );
+    add_balance( to, quantity, payer, st );
+}
+
+void token::transfers( const name& from, const std::vector<payment>& payments )
+{
+    require_auth( from );
+    check( !payments.empty(), "no payments to transfer" );
+    auto sym = payments.front().quantity.symbol;
+    stats statstable( get_self(), sym.code().raw() );
+    const auto& st = statstable.get( sym.code().raw() );
+    check( sym == st.supply.symbol, "symbol precision mismatch" );
+
+    require_recipient( from );
+
+    asset total( 0, sym );
+    for( const auto& p : payments ) {
+        check( from != p.to, "cannot transfer to self" );
+        check( is_account( p.to ), "to account does not exist");
+        check( p.quantity.is_valid(), "invalid quantity" );
+        check( p.quantity.amount > 0, "must transfer positive quantity" );
+        check( p.quantity.symbol == sym, "symbol precision mismatch" );
+        check( p.memo.size() <= 256, "memo has more than 256 bytes" );
+
+        require_recipient( p.to );
+        total += p.quantity;
+    }
+
+    sub_balance( from, total, st );
+    for( const auto& p : payments ) {
+        add_balance( p.to, p.quantity, has_auth( p.to ) ? p.to : from, st );
+    }
 }
 
-void token::sub_balance( const name& owner, const asset& value ) {
+void token::sub_balance( const name& owner, const asset& value, const currency_stats& st ) {
    accounts from_acnts( get_self(), owner.value );
 
    const auto& from = from_acnts.get( value.symbol.code().raw(), "no balance object found" );
    check( from.balance.amount >= value.amount, "overdrawn balance" );
 
+   checkpoint_balance( owner, from.balance, owner, st );
+
    from_acnts.modify( from, owner, [&]( auto& a ) {
          a.balance -= value;
       });
 }
 
-void token::add_balance( const name& owner, const asset& value, const name& ram_payer )
+void token::add_balance( const name& owner, const asset& value, const name& ram_payer, const currency_stats& st )
 {
    accounts to_acnts( get_self(), owner.value );
    auto to = to_acnts.find( value.symbol.code().raw() );
    if( to == to_acnts.end() ) {
+      checkpoint_balance( owner, asset( 0, value.symbol ), ram_payer, st );
       to_acnts.emplace( ram_payer, [&]( auto& a ){
         a.balance = value;
       });
    } else {
+      checkpoint_balance( owner, to->balance, ram_payer, st );
       to_acnts.modify( to, same_payer, [&]( auto& a ) {
         a.balance += value;
       });
    }
 }
 
+void token::checkpoint_balance( const name& owner, const asset& balance, const name& ram_payer, const currency_stats& st )
+{
+   if( !st.checkpoint_epoch ) {
+      return;
+   }
+   const uint32_t epoch = st.checkpoint_epoch.value();
+   const auto sym = balance.symbol.code();
+
+   // only the first change within an epoch is recorded
+   checkpoints ckpts( get_self(), owner.value );
+   auto idx = ckpts.get_index<"bysymepoch"_n>();
+   if( idx.find( checkpoint::key( sym, epoch ) ) != idx.end() ) {
+      return;
+   }
+
+   // checkpoints no longer needed by get_balance_at are erased, which refunds their payers
+   if( epoch >= checkpoint_retention ) {
+      const auto retained = checkpoint::key( sym, epoch - checkpoint_retention + 1 );
+      for( auto itr = idx.lower_bound( checkpoint::key( sym, 0 ) ); itr != idx.end() && itr->by_symbol_epoch() < retained; ) {
+         itr = idx.erase( itr );
+      }
+   }
+
+   ckpts.emplace( ram_payer, [&]( auto& c ) {
+      c.id      = ckpts.available_primary_key();
+      c.epoch   = epoch;
+      c.balance = balance;
+   });
+}
+
 void token::open( const name& owner, const symbol& symbol, const name& ram_payer )
 {
    require_auth( ram_payer );
@@ -156,4 +256,28 @@ void token::close( const name& owner, const symbol& symbol )
    acnts.erase( it );
 }
 
+void token::enableckpt( const symbol_code& sym )
+{
+   stats statstable( get_self(), sym.raw() );
+   const auto& st = statstable.get( sym.raw(), "symbol does not exist" );
+   require_auth( st.issuer );
+
+   check( !st.checkpoint_epoch, "checkpoints already enabled" );
+   statstable.modify( st, same_payer, [&]( auto& s ) {
+      s.checkpoint_epoch.emplace( 0 );
+   });
+}
+
+void token::newepoch( const symbol_code& sym )
+{
+   stats statstable( get_self(), sym.raw() );
+   const auto& st = statstable.get( sym.raw(), "symbol does not exist" );
+   require_auth( st.issuer );
+
+   check( st.checkpoint_epoch.has_value(), "checkpoints not enabled" );
+   statstable.modify( st, same_payer, [&]( auto& s ) {
+      s.checkpoint_epoch.value()++;
+   });
+}
+
 } /// namespace eosio
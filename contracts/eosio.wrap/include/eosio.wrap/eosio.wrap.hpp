@@ -36,7 +36,23 @@ namespace eosio {
          [[eosio::action]]
          void exec( ignore<name> executer, ignore<transaction> trx );
 
+         /**
+          * Execute inline action.
+          *
+          * @details Same as `exec`, but the actions of `trx` are dispatched as inline actions of the
+          * current transaction instead of a deferred transaction, so their results are part of this
+          * action's trace. `trx` must not have a delay and must not contain context-free actions.
+          *
+          * @param executer - account executing the transaction,
+          * @param trx - the transaction to be executed.
+          *
+          * @pre Requires authorization of eosio.wrap which needs to be a privileged account.
+          */
+         [[eosio::action]]
+         void execinline( ignore<name> executer, ignore<transaction> trx );
+
          using exec_action = eosio::action_wrapper<"exec"_n, &wrap::exec>;
+         using execinline_action = eosio::action_wrapper<"execinline"_n, &wrap::execinline>;
    };
    /** @}*/ // end of @defgroup eosiowrap eosio.wrap
 } /// namespace eosio
@@ -14,4 +14,20 @@ void wrap::exec( ignore<name>, ignore<transaction> ) {
                   executer, _ds.pos(), _ds.remaining() );
 }
 
+void wrap::execinline( ignore<name>, ignore<transaction> ) {
+   require_auth( get_self() );
+
+   name executer;
+   transaction trx;
+   _ds >> executer >> trx;
+
+   require_auth( executer );
+
+   check( trx.delay_sec.value == 0, "inline execution requires a transaction without delay" );
+   check( trx.context_free_actions.empty(), "inline execution does not support context-free actions" );
+   for ( const auto& act : trx.actions ) {
+      act.send();
+   }
+}
+
 } /// namespace eosio
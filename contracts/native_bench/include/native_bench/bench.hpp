@@ -0,0 +1,47 @@
+#pragma once
+
+#include <eosio/name.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace native_bench {
+
+   /**
+    * Runs `f`, which performs `ops` operations, and prints one line with its wall time:
+    *
+    *    <name> ops=<n> total_ms=<ms> per_op_us=<us>
+    */
+   template<typename F>
+   void measure( const char* name, uint64_t ops, F&& f ) {
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+      std::printf( "%-28s ops=%-8llu total_ms=%-10.3f per_op_us=%.3f\n", name, (unsigned long long)ops,
+                   elapsed.count(), ops ? elapsed.count() * 1000. / ops : 0. );
+   }
+
+   /// Value of `--<name>=<n>` on the command line, or `default_value`
+   inline uint64_t option( int argc, char** argv, const char* name, uint64_t default_value ) {
+      const std::string prefix = std::string("--") + name + "=";
+      for( int i = 1; i < argc; ++i ) {
+         if( strncmp( argv[i], prefix.c_str(), prefix.size() ) == 0 )
+            return strtoull( argv[i] + prefix.size(), nullptr, 10 );
+      }
+      return default_value;
+   }
+
+   /// Distinct account names `<prefix>aaaaa`, `<prefix>aaaab`, ... for generated table rows
+   inline eosio::name account_name( const char* prefix, uint32_t n ) {
+      std::string suffix( 5, 'a' );
+      for( int i = 4; i >= 0 && n > 0; --i, n /= 26 ) {
+         suffix[i] = char('a' + n % 26);
+      }
+      return eosio::name( std::string(prefix) + suffix );
+   }
+
+} /// namespace native_bench
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <eosio/name.hpp>
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace native_bench {
+
+   /**
+    * In-memory chain state for contract code compiled with `-fnative`.
+    *
+    * @details `install()` routes the database, authorization, time, producer and resource limit
+    * intrinsics of the native CDT runtime to this object, so `multi_index` and `singleton` run
+    * unchanged on top of it. Rows are kept in ordered maps keyed by (code, scope, table) and
+    * secondary indices keep their (secondary, primary) pairs sorted, which gives the same iteration
+    * order as the chain. Authorization always succeeds and inline and deferred actions are only
+    * counted, not executed.
+    */
+   class mock_host {
+      public:
+         /// The host behind the installed intrinsics
+         static mock_host& instance();
+
+         /// Installs the intrinsics and makes `receiver` the contract that writes to the database
+         void install( eosio::name receiver );
+
+         void set_receiver( eosio::name receiver ) { _receiver = receiver; }
+         eosio::name receiver()const               { return _receiver; }
+
+         /// Microseconds since the epoch returned by `current_time`
+         void    set_time( int64_t usecs ) { _time = usecs; }
+         int64_t time()const               { return _time; }
+
+         /// Schedule returned by `get_active_producers`
+         void set_active_producers( std::vector<eosio::name> producers ) { _active_producers = std::move(producers); }
+
+         /// Writes a packed row as contract `code` would, e.g. a balance owned by another contract
+         void store_row( eosio::name code, uint64_t scope, eosio::name table, uint64_t primary, const std::vector<char>& value );
+
+         /// Number of rows in a table
+         size_t row_count( eosio::name code, uint64_t scope, eosio::name table )const;
+
+         uint64_t inline_actions   = 0;
+         uint64_t deferred_actions = 0;
+         uint64_t proposed_schedules = 0;
+
+      private:
+         mock_host() = default;
+
+         eosio::name                                                 _receiver;
+         int64_t                                                     _time = 0;
+         std::vector<eosio::name>                                    _active_producers;
+         std::map<uint64_t, std::tuple<int64_t, int64_t, int64_t>>  _resource_limits;
+   };
+
+} /// namespace native_bench
@@ -0,0 +1,427 @@
+#include <native_bench/mock_host.hpp>
+
+#include <eosio/check.hpp>
+#include <eosio/privileged.hpp>
+#include <eosio/tester.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <set>
+
+namespace native_bench {
+
+   using eosio::check;
+   using eosio::native::intrinsics;
+
+   namespace {
+
+      using table_key = std::tuple<uint64_t, uint64_t, uint64_t>; // code, scope, table
+
+      /**
+       * Iterator bookkeeping shared by the primary and secondary stores.
+       *
+       * @details As on the chain, an iterator to a row is a non-negative handle and the end
+       * iterator of a table is `-2 - <table index>`, so `previous` from the end can find the table.
+       * Handles are reused for the same row, which keeps long benchmarks from growing the cache.
+       */
+      template<typename Table>
+      class iterator_registry {
+         public:
+            Table& table( uint64_t code, uint64_t scope, uint64_t name ) {
+               auto result = _tables.try_emplace( table_key{ code, scope, name } );
+               if( result.second ) {
+                  result.first->second.index = int32_t(_by_index.size());
+                  _by_index.push_back( &result.first->second );
+               }
+               return result.first->second;
+            }
+
+            const Table* find_table( uint64_t code, uint64_t scope, uint64_t name )const {
+               auto itr = _tables.find( table_key{ code, scope, name } );
+               return itr == _tables.end() ? nullptr : &itr->second;
+            }
+
+            int32_t end_of( const Table& t )const { return -2 - t.index; }
+
+            Table& table_of_end( int32_t itr ) {
+               check( itr < -1 && size_t(-2 - itr) < _by_index.size(), "invalid end iterator" );
+               return *_by_index[-2 - itr];
+            }
+
+            int32_t iterator_to( Table& t, uint64_t primary ) {
+               auto result = _cache.try_emplace( { &t, primary }, int32_t(_iterators.size()) );
+               if( result.second ) {
+                  _iterators.emplace_back( &t, primary );
+               }
+               return result.first->second;
+            }
+
+            const std::pair<Table*, uint64_t>& at( int32_t itr )const {
+               check( itr >= 0 && size_t(itr) < _iterators.size(), "invalid iterator" );
+               return _iterators[itr];
+            }
+
+         private:
+            std::map<table_key, Table>                               _tables;
+            std::vector<Table*>                                      _by_index;
+            std::vector<std::pair<Table*, uint64_t>>                 _iterators;
+            std::map<std::pair<const Table*, uint64_t>, int32_t>     _cache;
+      };
+
+      struct primary_table {
+         std::map<uint64_t, std::vector<char>> rows;
+         int32_t                               index = 0;
+      };
+
+      class primary_store {
+         public:
+            int32_t store( uint64_t code, uint64_t scope, uint64_t table, uint64_t id, const void* data, uint32_t len ) {
+               auto& t = _registry.table( code, scope, table );
+               const char* bytes = static_cast<const char*>(data);
+               check( t.rows.emplace( id, std::vector<char>( bytes, bytes + len ) ).second, "primary key already exists" );
+               return _registry.iterator_to( t, id );
+            }
+
+            void update( int32_t itr, const void* data, uint32_t len ) {
+               const auto& row = _registry.at( itr );
+               const char* bytes = static_cast<const char*>(data);
+               row.first->rows.at( row.second ).assign( bytes, bytes + len );
+            }
+
+            void remove( int32_t itr ) {
+               const auto& row = _registry.at( itr );
+               row.first->rows.erase( row.second );
+            }
+
+            int32_t get( int32_t itr, void* data, uint32_t len ) {
+               const auto& row   = _registry.at( itr );
+               const auto& value = row.first->rows.at( row.second );
+               if( len > 0 ) {
+                  memcpy( data, value.data(), std::min<size_t>( len, value.size() ) );
+               }
+               return int32_t(value.size());
+            }
+
+            int32_t next( int32_t itr, uint64_t* primary ) {
+               if( itr < 0 ) return -1;
+               const auto& row = _registry.at( itr );
+               auto next = row.first->rows.upper_bound( row.second );
+               return iterator_or_end( *row.first, next, primary );
+            }
+
+            int32_t previous( int32_t itr, uint64_t* primary ) {
+               if( itr < -1 ) {
+                  auto& t = _registry.table_of_end( itr );
+                  if( t.rows.empty() ) return -1;
+                  *primary = t.rows.rbegin()->first;
+                  return _registry.iterator_to( t, *primary );
+               }
+               if( itr < 0 ) return -1;
+               const auto& row = _registry.at( itr );
+               auto current = row.first->rows.lower_bound( row.second );
+               if( current == row.first->rows.begin() ) return -1;
+               --current;
+               *primary = current->first;
+               return _registry.iterator_to( *row.first, current->first );
+            }
+
+            int32_t find( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               auto& t = _registry.table( code, scope, table );
+               return t.rows.count( id ) ? _registry.iterator_to( t, id ) : _registry.end_of( t );
+            }
+
+            int32_t lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               auto& t = _registry.table( code, scope, table );
+               uint64_t primary = 0;
+               return iterator_or_end( t, t.rows.lower_bound( id ), &primary );
+            }
+
+            int32_t upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               auto& t = _registry.table( code, scope, table );
+               uint64_t primary = 0;
+               return iterator_or_end( t, t.rows.upper_bound( id ), &primary );
+            }
+
+            int32_t end( uint64_t code, uint64_t scope, uint64_t table ) {
+               return _registry.end_of( _registry.table( code, scope, table ) );
+            }
+
+            size_t size( uint64_t code, uint64_t scope, uint64_t table )const {
+               const auto* t = _registry.find_table( code, scope, table );
+               return t ? t->rows.size() : 0;
+            }
+
+         private:
+            template<typename Iterator>
+            int32_t iterator_or_end( primary_table& t, Iterator itr, uint64_t* primary ) {
+               if( itr == t.rows.end() ) return _registry.end_of( t );
+               *primary = itr->first;
+               return _registry.iterator_to( t, itr->first );
+            }
+
+            iterator_registry<primary_table> _registry;
+      };
+
+      /// Secondary index of type `Key`, ordered by (secondary, primary) like the chain's
+      template<typename Key>
+      struct secondary_table {
+         std::set<std::pair<Key, uint64_t>> entries;
+         std::map<uint64_t, Key>            keys;
+         int32_t                            index = 0;
+      };
+
+      template<typename Key>
+      class secondary_store {
+         public:
+            int32_t store( uint64_t code, uint64_t scope, uint64_t table, uint64_t id, const Key* secondary ) {
+               auto& t = _registry.table( code, scope, table );
+               check( t.keys.emplace( id, *secondary ).second, "secondary key already exists for this primary key" );
+               t.entries.emplace( *secondary, id );
+               return _registry.iterator_to( t, id );
+            }
+
+            void update( int32_t itr, const Key* secondary ) {
+               const auto& row = _registry.at( itr );
+               auto& key = row.first->keys.at( row.second );
+               row.first->entries.erase( { key, row.second } );
+               key = *secondary;
+               row.first->entries.emplace( key, row.second );
+            }
+
+            void remove( int32_t itr ) {
+               const auto& row = _registry.at( itr );
+               auto key = row.first->keys.find( row.second );
+               check( key != row.first->keys.end(), "invalid iterator" );
+               row.first->entries.erase( { key->second, row.second } );
+               row.first->keys.erase( key );
+            }
+
+            int32_t next( int32_t itr, uint64_t* primary ) {
+               if( itr < 0 ) return -1;
+               const auto& row = _registry.at( itr );
+               auto& t = *row.first;
+               return iterator_or_end( t, t.entries.upper_bound( { t.keys.at( row.second ), row.second } ), primary );
+            }
+
+            int32_t previous( int32_t itr, uint64_t* primary ) {
+               if( itr < -1 ) {
+                  auto& t = _registry.table_of_end( itr );
+                  if( t.entries.empty() ) return -1;
+                  *primary = t.entries.rbegin()->second;
+                  return _registry.iterator_to( t, *primary );
+               }
+               if( itr < 0 ) return -1;
+               const auto& row = _registry.at( itr );
+               auto& t = *row.first;
+               auto current = t.entries.lower_bound( { t.keys.at( row.second ), row.second } );
+               if( current == t.entries.begin() ) return -1;
+               --current;
+               *primary = current->second;
+               return _registry.iterator_to( t, current->second );
+            }
+
+            int32_t find_primary( uint64_t code, uint64_t scope, uint64_t table, Key* secondary, uint64_t primary ) {
+               auto& t = _registry.table( code, scope, table );
+               auto key = t.keys.find( primary );
+               if( key == t.keys.end() ) return _registry.end_of( t );
+               *secondary = key->second;
+               return _registry.iterator_to( t, primary );
+            }
+
+            int32_t find_secondary( uint64_t code, uint64_t scope, uint64_t table, const Key* secondary, uint64_t* primary ) {
+               auto& t = _registry.table( code, scope, table );
+               auto itr = t.entries.lower_bound( { *secondary, 0 } );
+               if( itr == t.entries.end() || itr->first != *secondary ) return _registry.end_of( t );
+               *primary = itr->second;
+               return _registry.iterator_to( t, itr->second );
+            }
+
+            int32_t lowerbound( uint64_t code, uint64_t scope, uint64_t table, Key* secondary, uint64_t* primary ) {
+               auto& t = _registry.table( code, scope, table );
+               return bound( t, t.entries.lower_bound( { *secondary, 0 } ), secondary, primary );
+            }
+
+            int32_t upperbound( uint64_t code, uint64_t scope, uint64_t table, Key* secondary, uint64_t* primary ) {
+               auto& t = _registry.table( code, scope, table );
+               return bound( t, t.entries.upper_bound( { *secondary, std::numeric_limits<uint64_t>::max() } ), secondary, primary );
+            }
+
+            int32_t end( uint64_t code, uint64_t scope, uint64_t table ) {
+               return _registry.end_of( _registry.table( code, scope, table ) );
+            }
+
+         private:
+            template<typename Iterator>
+            int32_t iterator_or_end( secondary_table<Key>& t, Iterator itr, uint64_t* primary ) {
+               if( itr == t.entries.end() ) return _registry.end_of( t );
+               *primary = itr->second;
+               return _registry.iterator_to( t, itr->second );
+            }
+
+            template<typename Iterator>
+            int32_t bound( secondary_table<Key>& t, Iterator itr, Key* secondary, uint64_t* primary ) {
+               if( itr == t.entries.end() ) return _registry.end_of( t );
+               *secondary = itr->first;
+               *primary   = itr->second;
+               return _registry.iterator_to( t, itr->second );
+            }
+
+            iterator_registry<secondary_table<Key>> _registry;
+      };
+
+      primary_store             rows;
+      secondary_store<uint64_t> idx64;
+      secondary_store<double>   idx_double;
+
+   } /// anonymous namespace
+
+   mock_host& mock_host::instance() {
+      static mock_host host;
+      return host;
+   }
+
+   void mock_host::store_row( eosio::name code, uint64_t scope, eosio::name table, uint64_t primary, const std::vector<char>& value ) {
+      rows.store( code.value, scope, table.value, primary, value.data(), uint32_t(value.size()) );
+   }
+
+   size_t mock_host::row_count( eosio::name code, uint64_t scope, eosio::name table )const {
+      return rows.size( code.value, scope, table.value );
+   }
+
+   void mock_host::install( eosio::name receiver ) {
+      _receiver = receiver;
+
+      /// primary index
+      intrinsics::set_intrinsic<intrinsics::db_store_i64>(
+         [this]( uint64_t scope, uint64_t table, uint64_t, uint64_t id, const void* data, uint32_t len ) {
+            return rows.store( _receiver.value, scope, table, id, data, len );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_update_i64>(
+         []( int32_t itr, uint64_t, const void* data, uint32_t len ) { rows.update( itr, data, len ); });
+      intrinsics::set_intrinsic<intrinsics::db_remove_i64>(
+         []( int32_t itr ) { rows.remove( itr ); });
+      intrinsics::set_intrinsic<intrinsics::db_get_i64>(
+         []( int32_t itr, const void* data, uint32_t len ) { return rows.get( itr, const_cast<void*>(data), len ); });
+      intrinsics::set_intrinsic<intrinsics::db_next_i64>(
+         []( int32_t itr, uint64_t* primary ) { return rows.next( itr, primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_previous_i64>(
+         []( int32_t itr, uint64_t* primary ) { return rows.previous( itr, primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_find_i64>(
+         []( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) { return rows.find( code, scope, table, id ); });
+      intrinsics::set_intrinsic<intrinsics::db_lowerbound_i64>(
+         []( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) { return rows.lowerbound( code, scope, table, id ); });
+      intrinsics::set_intrinsic<intrinsics::db_upperbound_i64>(
+         []( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) { return rows.upperbound( code, scope, table, id ); });
+      intrinsics::set_intrinsic<intrinsics::db_end_i64>(
+         []( uint64_t code, uint64_t scope, uint64_t table ) { return rows.end( code, scope, table ); });
+
+      /// uint64_t secondary indices
+      intrinsics::set_intrinsic<intrinsics::db_idx64_store>(
+         [this]( uint64_t scope, uint64_t table, uint64_t, uint64_t id, const uint64_t* secondary ) {
+            return idx64.store( _receiver.value, scope, table, id, secondary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_update>(
+         []( int32_t itr, uint64_t, const uint64_t* secondary ) { idx64.update( itr, secondary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_remove>(
+         []( int32_t itr ) { idx64.remove( itr ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_next>(
+         []( int32_t itr, uint64_t* primary ) { return idx64.next( itr, primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_previous>(
+         []( int32_t itr, uint64_t* primary ) { return idx64.previous( itr, primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_find_primary>(
+         []( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t primary ) {
+            return idx64.find_primary( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_find_secondary>(
+         []( uint64_t code, uint64_t scope, uint64_t table, const uint64_t* secondary, uint64_t* primary ) {
+            return idx64.find_secondary( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_lowerbound>(
+         []( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary ) {
+            return idx64.lowerbound( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_upperbound>(
+         []( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary ) {
+            return idx64.upperbound( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx64_end>(
+         []( uint64_t code, uint64_t scope, uint64_t table ) { return idx64.end( code, scope, table ); });
+
+      /// double secondary indices, used by the producers table
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_store>(
+         [this]( uint64_t scope, uint64_t table, uint64_t, uint64_t id, const double* secondary ) {
+            return idx_double.store( _receiver.value, scope, table, id, secondary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_update>(
+         []( int32_t itr, uint64_t, const double* secondary ) { idx_double.update( itr, secondary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_remove>(
+         []( int32_t itr ) { idx_double.remove( itr ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_next>(
+         []( int32_t itr, uint64_t* primary ) { return idx_double.next( itr, primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_previous>(
+         []( int32_t itr, uint64_t* primary ) { return idx_double.previous( itr, primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_find_primary>(
+         []( uint64_t code, uint64_t scope, uint64_t table, double* secondary, uint64_t primary ) {
+            return idx_double.find_primary( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_find_secondary>(
+         []( uint64_t code, uint64_t scope, uint64_t table, const double* secondary, uint64_t* primary ) {
+            return idx_double.find_secondary( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_lowerbound>(
+         []( uint64_t code, uint64_t scope, uint64_t table, double* secondary, uint64_t* primary ) {
+            return idx_double.lowerbound( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_upperbound>(
+         []( uint64_t code, uint64_t scope, uint64_t table, double* secondary, uint64_t* primary ) {
+            return idx_double.upperbound( code, scope, table, secondary, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx_double_end>(
+         []( uint64_t code, uint64_t scope, uint64_t table ) { return idx_double.end( code, scope, table ); });
+
+      /// authorization and accounts
+      intrinsics::set_intrinsic<intrinsics::require_auth>( []( uint64_t ) {} );
+      intrinsics::set_intrinsic<intrinsics::require_auth2>( []( uint64_t, uint64_t ) {} );
+      intrinsics::set_intrinsic<intrinsics::has_auth>( []( uint64_t ) { return true; } );
+      intrinsics::set_intrinsic<intrinsics::is_account>( []( uint64_t ) { return true; } );
+      intrinsics::set_intrinsic<intrinsics::require_recipient>( []( uint64_t ) {} );
+      intrinsics::set_intrinsic<intrinsics::current_receiver>( [this]() { return _receiver.value; } );
+
+      /// time and transactions
+      intrinsics::set_intrinsic<intrinsics::current_time>( [this]() { return uint64_t(_time); } );
+      intrinsics::set_intrinsic<intrinsics::send_inline>( [this]( char*, size_t ) { ++inline_actions; } );
+      intrinsics::set_intrinsic<intrinsics::send_deferred>(
+         [this]( const uint128_t&, uint64_t, const char*, size_t, uint32_t ) { ++deferred_actions; });
+      intrinsics::set_intrinsic<intrinsics::cancel_deferred>( []( const uint128_t& ) { return 0; } );
+
+      /// producers and resources
+      intrinsics::set_intrinsic<intrinsics::get_active_producers>(
+         [this]( uint64_t* producers, uint32_t datalen ) {
+            const uint32_t size = uint32_t(_active_producers.size() * sizeof(uint64_t));
+            if( datalen > 0 ) {
+               memcpy( producers, _active_producers.data(), std::min( datalen, size ) );
+            }
+            return size;
+         });
+      intrinsics::set_intrinsic<intrinsics::set_proposed_producers>(
+         [this]( char*, uint32_t ) { return int64_t(++proposed_schedules); });
+      intrinsics::set_intrinsic<intrinsics::get_resource_limits>(
+         [this]( uint64_t account, int64_t* ram_bytes, int64_t* net_weight, int64_t* cpu_weight ) {
+            std::tie( *ram_bytes, *net_weight, *cpu_weight ) = _resource_limits[account];
+         });
+      intrinsics::set_intrinsic<intrinsics::set_resource_limits>(
+         [this]( uint64_t account, int64_t ram_bytes, int64_t net_weight, int64_t cpu_weight ) {
+            _resource_limits[account] = std::make_tuple( ram_bytes, net_weight, cpu_weight );
+         });
+      intrinsics::set_intrinsic<intrinsics::get_blockchain_parameters_packed>(
+         []( char* data, uint32_t datalen ) {
+            static const auto packed = eosio::pack( eosio::blockchain_parameters{} );
+            if( datalen > 0 ) {
+               memcpy( data, packed.data(), std::min<size_t>( datalen, packed.size() ) );
+            }
+            return uint32_t(packed.size());
+         });
+   }
+
+} /// namespace native_bench
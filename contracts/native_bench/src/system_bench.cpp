@@ -0,0 +1,193 @@
+/**
+ * Native microbenchmarks of eosio.system: the bancor math of the ram market and REX, the producer
+ * schedule update and uptime tracking of `onblock`, and the expired loan processing of `runrex`.
+ *
+ * Every action runs on a fresh `system_contract`, as it would on the chain, against the in-memory
+ * state of `mock_host`. Table sizes are set on the command line:
+ *
+ *    system_bench [--iterations=<n>] [--producers=<n>] [--loans=<n>]
+ */
+#include <native_bench/bench.hpp>
+#include <native_bench/mock_host.hpp>
+
+#include <eosio.system/eosio.system.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace eosio;
+using namespace eosiosystem;
+using native_bench::account_name;
+using native_bench::measure;
+using native_bench::mock_host;
+
+namespace {
+
+   const name     system_account = "eosio"_n;
+   const symbol   core           = symbol( "WBI", 4 );
+   const int64_t  start_time     = 1'600'000'000ll * 1000'000ll;
+
+   /// Runs `f` on a contract constructed for one action with `data` as its action data
+   template<typename F>
+   void run_action( const std::vector<char>& data, F&& f ) {
+      system_contract contract( system_account, system_account, datastream<const char*>( data.data(), data.size() ) );
+      f( contract );
+   }
+
+   template<typename F>
+   void run_action( F&& f ) {
+      run_action( std::vector<char>(), std::forward<F>(f) );
+   }
+
+   void init_rammarket() {
+      rammarket market( system_account, system_account.value );
+      market.emplace( system_account, [&]( auto& m ) {
+         m.supply.amount        = 100000000000000ll;
+         m.supply.symbol        = system_contract::ramcore_symbol;
+         m.base.balance.amount  = 64ll * 1024 * 1024 * 1024;
+         m.base.balance.symbol  = system_contract::ram_symbol;
+         m.quote.balance.amount = 1'000'000'0000ll;
+         m.quote.balance.symbol = core;
+      });
+   }
+
+   void bench_exchange( uint64_t iterations ) {
+      rammarket market( system_account, system_account.value );
+      exchange_state state = *market.begin();
+      volatile int64_t sink = 0;
+
+      measure( "exchange direct_convert", 2 * iterations, [&] {
+         for( uint64_t i = 0; i < iterations; ++i ) {
+            const auto bytes = state.direct_convert( asset( 10'0000, core ), system_contract::ram_symbol );
+            sink = sink + state.direct_convert( bytes, core ).amount;
+         }
+      });
+
+      measure( "exchange convert", 2 * iterations, [&] {
+         for( uint64_t i = 0; i < iterations; ++i ) {
+            const auto bytes = state.convert( asset( 10'0000, core ), system_contract::ram_symbol );
+            sink = sink + state.convert( bytes, core ).amount;
+         }
+      });
+
+      measure( "bancor output+input", 2 * iterations, [&] {
+         for( uint64_t i = 0; i < iterations; ++i ) {
+            sink = sink + exchange_state::get_bancor_output( 1'000'000'0000ll, 50'000'0000ll, 1'0000 + int64_t(i) );
+            sink = sink + exchange_state::get_bancor_input( 50'000'0000ll, 1'000'000'0000ll, 1'0000 + int64_t(i) );
+         }
+      });
+   }
+
+   /// Registers `count` active producers with keys and returns the first 21 as the active schedule
+   std::vector<name> init_producers( uint32_t count ) {
+      std::vector<name> schedule;
+      for( uint32_t i = 0; i < count; ++i ) {
+         const name producer = account_name( "prod", i );
+         eosio::public_key key;
+         key.data[1] = char(i & 0xff);
+         key.data[2] = char((i >> 8) & 0xff);
+         key.data[3] = 1;
+
+         run_action( [&]( auto& c ) { c.addprod( producer ); } );
+         run_action( [&]( auto& c ) { c.promoteprod( producer ); } );
+         run_action( [&]( auto& c ) { c.regproducer( producer, key, "https://" + producer.to_string() + ".io", 0 ); } );
+         if( schedule.size() < 21 ) schedule.push_back( producer );
+      }
+      std::sort( schedule.begin(), schedule.end() );
+      run_action( []( auto& c ) { c.togglesched( true ); } );
+      return schedule;
+   }
+
+   void bench_onblock( uint64_t iterations, uint32_t producers ) {
+      auto& host = mock_host::instance();
+      const auto schedule = init_producers( producers );
+      host.set_active_producers( schedule );
+
+      const auto packed_header = [&]( uint32_t slot, name producer ) {
+         return eosio::pack( std::make_tuple( block_timestamp( slot ), producer, uint16_t(0),
+                                              checksum256(), checksum256(), checksum256(), uint32_t(1) ) );
+      };
+
+      /// every block is more than a minute after the previous schedule update
+      uint32_t slot = block_timestamp( time_point( microseconds( start_time ) ) ).slot;
+      measure( "onblock schedule update", iterations, [&] {
+         for( uint64_t i = 0; i < iterations; ++i ) {
+            slot += 121;
+            run_action( packed_header( slot, schedule[i % schedule.size()] ), []( auto& c ) { c.onblock( {} ); } );
+         }
+      });
+
+      /// blocks in between, which only record the producer and its uptime
+      measure( "onblock", iterations, [&] {
+         for( uint64_t i = 0; i < iterations; ++i ) {
+            run_action( packed_header( ++slot, schedule[i % schedule.size()] ), []( auto& c ) { c.onblock( {} ); } );
+         }
+      });
+   }
+
+   /// Creates `count` expired cpu loans, every other one funded well enough to be renewed
+   void init_rex( uint32_t count ) {
+      const asset staked( 10'0000, core );
+      const asset payment( 1'0000, core );
+
+      rex_pool_table pool( system_account, system_account.value );
+      pool.emplace( system_account, [&]( auto& p ) {
+         p.total_lent       = asset( staked.amount * count, core );
+         p.total_unlent     = asset( 100'000'000'0000ll, core );
+         p.total_rent       = asset( 10'000'0000ll, core );
+         p.total_lendable   = p.total_unlent + p.total_lent;
+         p.total_rex        = asset( 1'000'000'000'000'0000ll, system_contract::rex_symbol );
+         p.namebid_proceeds = asset( 0, core );
+         p.loan_num         = count;
+      });
+
+      rex_cpu_loan_table loans( system_account, system_account.value );
+      for( uint32_t i = 0; i < count; ++i ) {
+         const name owner = account_name( "rexuser", i );
+         loans.emplace( system_account, [&]( auto& l ) {
+            l.from         = owner;
+            l.receiver     = owner;
+            l.payment      = payment;
+            l.balance      = i % 2 ? asset( 0, core ) : asset( 2 * payment.amount, core );
+            l.total_staked = staked;
+            l.loan_num     = i + 1;
+            l.expiration   = time_point( microseconds( start_time - int64_t(count - i) * 1000'000ll ) );
+         });
+
+         user_resources_table totals( system_account, owner.value );
+         totals.emplace( system_account, [&]( auto& t ) {
+            t.owner      = owner;
+            t.net_weight = asset( 0, core );
+            t.cpu_weight = staked;
+         });
+      }
+   }
+
+   void bench_runrex( uint32_t loans ) {
+      init_rex( loans );
+      measure( "runrex expired loans", loans, [&] {
+         run_action( [&]( auto& c ) { c.rexexec( system_account, uint16_t(loans) ); } );
+      });
+   }
+
+} /// anonymous namespace
+
+int main( int argc, char** argv ) {
+   const uint64_t iterations = native_bench::option( argc, argv, "iterations", 1000 );
+   const uint32_t producers  = uint32_t(std::max<uint64_t>( 1, native_bench::option( argc, argv, "producers", 100 ) ));
+   const uint32_t loans      = uint32_t(std::min<uint64_t>( 65535, native_bench::option( argc, argv, "loans", 1000 ) ));
+
+   auto& host = mock_host::instance();
+   host.install( system_account );
+   host.set_time( start_time );
+
+   init_rammarket();
+
+   bench_exchange( iterations * 100 );
+   bench_onblock( iterations, producers );
+   bench_runrex( loans );
+
+   std::printf( "inline actions=%llu schedules proposed=%llu\n",
+                (unsigned long long)host.inline_actions, (unsigned long long)host.proposed_schedules );
+   return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Native microbenchmarks of the worblitimelock release logic: `claim` releasing every due
+ * condition of a recipient, and `updatercpnt` releasing an added amount against the conditions a
+ * recipient already met.
+ *
+ * Every action runs on a fresh contract against the in-memory state of `mock_host`. Table sizes
+ * are set on the command line:
+ *
+ *    timelock_bench [--recipients=<n>] [--conditions=<n>]
+ */
+#include <native_bench/bench.hpp>
+#include <native_bench/mock_host.hpp>
+
+#include "../../worblitimelock/src/worblitimelock.cpp"
+
+#include <algorithm>
+
+using native_bench::account_name;
+using native_bench::measure;
+using native_bench::mock_host;
+
+namespace {
+
+   const name     timelock_account = name("founders");
+   const int64_t  start_time       = 1'600'000'000ll * 1000'000ll;
+
+   /// Runs `f` on a contract constructed for one action
+   template<typename F>
+   void run_action( F&& f ) {
+      worblitimelock contract( timelock_account, timelock_account, datastream<const char*>( nullptr, 0 ) );
+      f( contract );
+   }
+
+   /// Funds the escrow and creates `conditions` due conditions and `recipients` recipients that met none
+   void init_timelock( uint32_t recipients, uint32_t conditions ) {
+      auto& host = mock_host::instance();
+
+      /// eosio.token balance of the escrow, read once when the escrow state is seeded
+      const asset funds( 1'000'000'000'0000ll, WBI_SYMBOL );
+      host.store_row( name("eosio.token"), timelock_account.value, name("accounts"), WBI_SYMBOL.code().raw(), pack( funds ) );
+      run_action( [&]( auto& c ) { c.ontransfer( name("eosio.token"), timelock_account, funds, "" ); } );
+
+      for( uint32_t i = 0; i < conditions; ++i ) {
+         const auto release = time_point_sec( uint32_t(start_time / 1000'000ll) - (conditions - i) * 86400 );
+         run_action( [&]( auto& c ) {
+            c.setcondition( account_name( "cond", i ), 100000 / conditions, "release " + std::to_string(i), release );
+         });
+      }
+
+      std::vector<name> none;
+      for( uint32_t i = 0; i < recipients; ++i ) {
+         run_action( [&]( auto& c ) { c.addrcpnt( account_name( "rcpnt", i ), asset( 1000'0000, WBI_SYMBOL ), none ); } );
+      }
+   }
+
+} /// anonymous namespace
+
+int main( int argc, char** argv ) {
+   const uint32_t recipients = uint32_t(native_bench::option( argc, argv, "recipients", 1000 ));
+   const uint32_t conditions = uint32_t(std::max<uint64_t>( 1, native_bench::option( argc, argv, "conditions", 10 ) ));
+
+   auto& host = mock_host::instance();
+   host.install( timelock_account );
+   host.set_time( start_time );
+
+   init_timelock( recipients, conditions );
+
+   measure( "claim", recipients, [&] {
+      for( uint32_t i = 0; i < recipients; ++i ) {
+         run_action( [&]( auto& c ) { c.claim( account_name( "rcpnt", i ) ); } );
+      }
+   });
+
+   measure( "updatercpnt", recipients, [&] {
+      for( uint32_t i = 0; i < recipients; ++i ) {
+         run_action( [&]( auto& c ) { c.updatercpnt( account_name( "rcpnt", i ), asset( 10'0000, WBI_SYMBOL ) ); } );
+      }
+   });
+
+   std::printf( "inline actions=%llu\n", (unsigned long long)host.inline_actions );
+   return 0;
+}
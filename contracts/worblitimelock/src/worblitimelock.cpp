@@ -1,8 +1,10 @@
 #include <eosiolib/eosio.hpp>
 #include <eosiolib/asset.hpp>
 #include <eosiolib/multi_index.hpp>
+#include <eosiolib/singleton.hpp>
 #include <eosiolib/time.hpp>
 #include "worblitimelock.hpp"
+#include <arena_allocator.hpp>
 
 
 using namespace eosio;
@@ -14,9 +16,15 @@ public:
   :contract(self, code, ds),
     _conditions(self, self.value),
     _recipients(self, self.value), 
-    _variables(self, self.value)
+    _variables(self, self.value),
+    _escrow(self, self.value)
   {  }
 
+#if CONTRACTS_MEMORY_STATS
+  // reports the heap use of the action, see memory_stats.hpp
+  ~worblitimelock() { CONTRACT_MEMORY_REPORT(); }
+#endif
+
   // Each user meets certain criteria and gets a specified percentage of tokens released.
   // Description is used in payout memo
   struct [[eosio::table("conditions")]] condition {
@@ -75,6 +83,16 @@ public:
     asset        quantity;
     string       memo;
   };
+
+  // one entry of eosio.token::transfers
+  struct payment
+  {
+    name         to;
+    asset        quantity;
+    string       memo;
+
+    EOSLIB_SERIALIZE( payment, (to)(quantity)(memo) )
+  };
   
   
   // This adds a new WBI token recipient and their total amount of WBI.
@@ -152,6 +170,50 @@ public:
  
   }
 
+  // Keeps the escrow balance in sync with eosio.token so that liability checks
+  // never have to read the foreign accounts table.
+  [[eosio::on_notify("eosio.token::transfer")]]
+  void ontransfer (name from, name to, asset quantity, string memo)
+  {
+    if( quantity.symbol != WBI_SYMBOL ) return;
+    if( from != _self && to != _self ) return;
+
+    _track_escrow(to == _self ? quantity : -quantity);
+  }
+
+  [[eosio::on_notify("eosio.token::transfers")]]
+  void ontransfers (name from, std::vector<payment> payments)
+  {
+    // all payments of one transfers action share a symbol
+    if( payments.empty() || payments.front().quantity.symbol != WBI_SYMBOL ) return;
+
+    asset delta(0, WBI_SYMBOL);
+    bool involved = false;
+    for( const auto& p: payments ) {
+      if( from == _self ) { delta -= p.quantity; involved = true; }
+      if( p.to == _self ) { delta += p.quantity; involved = true; }
+    }
+    if( !involved ) return;
+
+    _track_escrow(delta);
+  }
+
+  // tokens issued straight to the escrow only notify through issuemany
+  [[eosio::on_notify("eosio.token::issuemany")]]
+  void onissuemany (std::vector<payment> payments)
+  {
+    if( payments.empty() || payments.front().quantity.symbol != WBI_SYMBOL ) return;
+
+    asset delta(0, WBI_SYMBOL);
+    bool involved = false;
+    for( const auto& p: payments ) {
+      if( p.to == _self ) { delta += p.quantity; involved = true; }
+    }
+    if( !involved ) return;
+
+    _track_escrow(delta);
+  }
+
   [[eosio::action]]
   void claim (name owner)
   {
@@ -160,6 +222,7 @@ public:
     auto rcptitr = _recipients.find(owner.value);
     check(rcptitr != _recipients.end(), "cannot find the owner in the database");
 
+    asset released(0, WBI_SYMBOL);
     for (auto itr = _conditions.begin(); itr != _conditions.end(); itr++) {
       auto cnditr = std::find(rcptitr->conditions.begin(), rcptitr->conditions.end(), (*itr).cond);
       
@@ -170,14 +233,39 @@ public:
         item.conditions.emplace_back((*itr).cond);
       });
 
-      _release_tokens(owner, (*itr).cond, rcptitr->total_tokens);
+      released += _release_tokens(owner, (*itr).cond, rcptitr->total_tokens);
  
     }
 
+    // dummy action added so that the released amount shows up in action trace,
+    // authorized by the payout permission, which claimresult has to be linked to
+    action
+      {
+        permission_level{_self, name("payout")},
+          _self,
+            name("claimresult"),
+            std::make_tuple(owner, released)
+      }.send();
+  }
+
+  [[eosio::action]]
+  void claimresult (name owner, asset released)
+  {
+    require_auth(_self);
   }
 
 private:
 
+  // escrow balance as last reported by eosio.token and the total amount of
+  // WBI still owed to recipients
+  struct [[eosio::table("escrow")]] escrow_state {
+    asset     balance = asset(0, WBI_SYMBOL);
+    int64_t   liabilities = 0;
+  };
+
+  typedef eosio::singleton<name("escrow"), escrow_state> escrow;
+
+  // legacy storage of liabilities, only read once when the escrow state is seeded
   struct [[eosio::table("variables")]] variable {
     name      key;
     int64_t   val_int;    
@@ -186,54 +274,61 @@ private:
 
   typedef eosio::multi_index<name("variables"), variable> variables;
 
-  int64_t _getvar_int(name key)
+  // eosio.token balance
+  struct account {
+    asset    balance;
+    uint64_t primary_key()const { return balance.symbol.raw(); }
+  };
+  
+  typedef eosio::multi_index<name("accounts"), account> accounts;
+
+  escrow_state _get_escrow()
   {
-    auto varitr = _variables.find(key.value);
-    if( varitr != _variables.end() ) {
-      return varitr->val_int;
+    if( _escrow.exists() ) {
+      return _escrow.get();
     }
-    return 0;
-  }
 
-  void _setvar_int(name key, int64_t val)
-  {
-    auto varitr = _variables.find(key.value);
+    // retrieve our WBI balance, this is the only read of the eosio.token tables
+    accounts accounts_index(name("eosio.token"), _self.value);
+    escrow_state state;
+    state.balance =
+      accounts_index.get(WBI_SYMBOL.code().raw(), "no balance object found").balance;
+
+    auto varitr = _variables.find(name("liabilities").value);
     if( varitr != _variables.end() ) {
-      _variables.modify( *varitr, _self, [&]( auto& item ) {
-          item.val_int = val;
-        });
-    }
-    else {
-      _variables.emplace(_self, [&]( auto& item ) {
-          item.key = key;
-          item.val_int = val;
-        });
+      state.liabilities = varitr->val_int;
+      _variables.erase(varitr);
     }
+    return state;
   }
 
+  // applies a balance change reported by eosio.token
+  void _track_escrow(asset delta)
+  {
+    // first notification seeds the state from eosio.token, which already
+    // includes this change
+    bool seeded = _escrow.exists();
+    auto state = _get_escrow();
 
-  // eosio.token balance
-  struct account {
-    asset    balance;
-    uint64_t primary_key()const { return balance.symbol.raw(); }
-  };
-  
-  typedef eosio::multi_index<name("accounts"), account> accounts;
+    if( seeded ) {
+      state.balance += delta;
+    }
+
+    _escrow.set(state, _self);
+  }
 
   // this works for negative amounts too
   void _add_liabilities(asset amount)
   {
-    // retrieve our WBI balance
-    accounts accounts_index(name("eosio.token"), _self.value);
-    asset current_balance =
-      accounts_index.get(WBI_SYMBOL.code().raw(), "no balance object found").balance;
+    auto state = _get_escrow();
 
     // make sure liabilities are affordable
-    int64_t total_liablilities = _getvar_int(name("liabilities")) + amount.amount;
+    int64_t total_liablilities = state.liabilities + amount.amount;
     check(total_liablilities >= 0, "Negative total liabilities");
-    check(total_liablilities <= current_balance.amount, "insufficient funds on escrow account");
+    check(total_liablilities <= state.balance.amount, "insufficient funds on escrow account");
 
-    _setvar_int(name("liabilities"), total_liablilities);
+    state.liabilities = total_liablilities;
+    _escrow.set(state, _self);
   }
 
    time_point current_time_point() {
@@ -241,7 +336,8 @@ private:
       return ct;
    }
   
-  void _release_tokens(name owner, name cond, asset base)
+  // returns the amount sent to the owner
+  asset _release_tokens(name owner, name cond, asset base)
   {
     auto& rcpt = _recipients.get(owner.value);
     auto& cnd = _conditions.get(cond.value);
@@ -274,12 +370,13 @@ private:
                 .quantity=to_release, .memo=cnd.description
                 }
         }.send();
+      return to_release;
     }
+    return asset(0, WBI_SYMBOL);
   }
   
   conditions _conditions;
   recipients _recipients;
   variables _variables;
+  escrow _escrow;
 };
-
-EOSIO_DISPATCH( worblitimelock, (setcondition)(updatercpnt)(addrcpnt)(claim) )
@@ -4,3 +4,9 @@ cd /eosio.contracts
 ./build.sh -c /usr/opt/eosio.cdt -e /opt/eosio -y
 cd build
 tar -pczf /artifacts/contracts.tar.gz *
+# the unit tests cover the default configuration only; make sure eosio.system still compiles
+# without REX and the ram market
+mkdir -p /eosio.contracts/build-trimmed
+cd /eosio.contracts/build-trimmed
+cmake -DCMAKE_TOOLCHAIN_FILE=/usr/opt/eosio.cdt/lib/cmake/eosio.cdt/EosioWasmToolchain.cmake -DSYSTEM_ENABLE_REX=OFF -DSYSTEM_ENABLE_RAMMARKET=OFF ../contracts
+make -j $(getconf _NPROCESSORS_ONLN) eosio.system
@@ -225,6 +225,75 @@ BOOST_FIXTURE_TEST_CASE( propose_approve_execute, eosio_msig_tester ) try {
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE( propose_approve_execinline, eosio_msig_tester ) try {
+   auto trx = reqauth("alice", {permission_level{N(alice), config::active_name}}, abi_serializer_max_time );
+
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+   );
+
+   //fail to execute before approval
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(execinline), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("executer",      "alice")
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("transaction authorization failed")
+   );
+
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+
+   bool scheduled = false;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      if( std::get<0>(p)->scheduled ) { scheduled = true; }
+   } );
+
+   auto trace = push_action( N(alice), N(execinline), mvo()
+                               ("proposer",      "alice")
+                               ("proposal_name", "first")
+                               ("executer",      "alice")
+   );
+
+   //the proposed action is executed within the exec transaction
+   BOOST_REQUIRE( !scheduled );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+   BOOST_REQUIRE_EQUAL( 2, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( "eosio", name{trace->action_traces[1].act.account} );
+   BOOST_REQUIRE_EQUAL( "reqauth", name{trace->action_traces[1].act.name} );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(proposal), N(first) ).empty() );
+
+   //delayed transactions are still executed as deferred transactions only
+   trx.delay_sec = 10;
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "second")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+   );
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "second")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(execinline), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "second")
+                                          ("executer",      "alice")
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("inline execution requires a transaction without delay")
+   );
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( propose_approve_unapprove, eosio_msig_tester ) try {
    auto trx = reqauth("alice", {permission_level{N(alice), config::active_name}}, abi_serializer_max_time );
 
@@ -986,4 +1055,564 @@ BOOST_FIXTURE_TEST_CASE( switch_proposal_and_fail_approve_with_hash, eosio_msig_
    );
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( approvemany_unapprovemany, eosio_msig_tester ) try {
+   auto trx1 = reqauth("alice", vector<permission_level>{ { N(alice), config::active_name }, { N(bob), config::active_name } }, abi_serializer_max_time );
+   auto trx2 = reqauth("bob", vector<permission_level>{ { N(alice), config::active_name }, { N(bob), config::active_name } }, abi_serializer_max_time );
+   auto trx1_hash = fc::sha256::hash( trx1 );
+
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx1)
+                  ("requested", vector<permission_level>{ { N(alice), config::active_name }, { N(bob), config::active_name } })
+   );
+   push_action( N(bob), N(propose), mvo()
+                  ("proposer",      "bob")
+                  ("proposal_name", "second")
+                  ("trx",           trx2)
+                  ("requested", vector<permission_level>{ { N(alice), config::active_name }, { N(bob), config::active_name } })
+   );
+
+   //fail to approve with hash meant for another proposal, nothing is approved
+   BOOST_REQUIRE_EXCEPTION( push_action( N(bob), N(approvemany), mvo()
+                                          ("level",     permission_level{ N(bob), config::active_name })
+                                          ("proposals", fc::variants({
+                                                mvo()("proposer", "alice")("proposal_name", "first")("proposal_hash", trx1_hash),
+                                                mvo()("proposer", "bob")("proposal_name", "second")("proposal_hash", trx1_hash)
+                                             }))
+                            ),
+                            eosio::chain::crypto_api_exception,
+                            fc_exception_message_is("hash mismatch")
+   );
+
+   //approve both proposals by alice and bob
+   push_action( N(bob), N(approvemany), mvo()
+                  ("level",     permission_level{ N(bob), config::active_name })
+                  ("proposals", fc::variants({
+                        mvo()("proposer", "alice")("proposal_name", "first")("proposal_hash", trx1_hash),
+                        mvo()("proposer", "bob")("proposal_name", "second")
+                     }))
+   );
+   push_action( N(alice), N(approvemany), mvo()
+                  ("level",     permission_level{ N(alice), config::active_name })
+                  ("proposals", fc::variants({
+                        mvo()("proposer", "alice")("proposal_name", "first"),
+                        mvo()("proposer", "bob")("proposal_name", "second")
+                     }))
+   );
+
+   //fail to approve twice
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(approvemany), mvo()
+                                          ("level",     permission_level{ N(alice), config::active_name })
+                                          ("proposals", fc::variants({
+                                                mvo()("proposer", "alice")("proposal_name", "first")
+                                             }))
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("approval is not on the list of requested approvals")
+   );
+
+   //revoke bob's approval of the second proposal only
+   push_action( N(bob), N(unapprovemany), mvo()
+                  ("level",     permission_level{ N(bob), config::active_name })
+                  ("proposals", fc::variants({
+                        mvo()("proposer", "bob")("proposal_name", "second")
+                     }))
+   );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(bob), N(unapprovemany), mvo()
+                                          ("level",     permission_level{ N(bob), config::active_name })
+                                          ("proposals", fc::variants({
+                                                mvo()("proposer", "bob")("proposal_name", "second")
+                                             }))
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("no approval previously granted")
+   );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(bob), N(exec), mvo()
+                                          ("proposer",      "bob")
+                                          ("proposal_name", "second")
+                                          ("executer",      "bob")
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("transaction authorization failed")
+   );
+
+   transaction_trace_ptr trace;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      const auto& t = std::get<0>(p);
+      if( t->scheduled ) { trace = t; }
+   } );
+
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   BOOST_REQUIRE( bool(trace) );
+   BOOST_REQUIRE_EQUAL( 1, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( approve_in_place_sorted, eosio_msig_tester ) try {
+   vector<permission_level> requested{ { N(carol), config::active_name },
+                                       { N(alice), config::active_name },
+                                       { N(bob), config::active_name } };
+   auto trx = reqauth("alice", requested, abi_serializer_max_time );
+
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested",     requested)
+   );
+
+   auto row_size = [&]() {
+      return get_row_by_account( N(eosio.msig), N(alice), N(approvals2), N(first) ).size();
+   };
+   const auto proposed_size = row_size();
+   BOOST_REQUIRE( proposed_size > 0 );
+
+   //approvals arrive in arbitrary order and are flipped in place
+   push_action( N(carol), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(carol), config::active_name })
+   );
+   BOOST_REQUIRE_EQUAL( proposed_size, row_size() );
+
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+   BOOST_REQUIRE_EQUAL( proposed_size, row_size() );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(approve), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("level",         permission_level{ N(alice), config::active_name })
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("approval is not on the list of requested approvals")
+   );
+
+   push_action( N(carol), N(unapprove), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(carol), config::active_name })
+   );
+   BOOST_REQUIRE_EQUAL( proposed_size, row_size() );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(bob), N(unapprove), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("level",         permission_level{ N(bob), config::active_name })
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("no approval previously granted")
+   );
+
+   push_action( N(bob), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(bob), config::active_name })
+   );
+
+   //fail because approval by carol was revoked
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(exec), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("executer",      "alice")
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("transaction authorization failed")
+   );
+
+   push_action( N(carol), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(carol), config::active_name })
+   );
+   BOOST_REQUIRE_EQUAL( proposed_size, row_size() );
+
+   transaction_trace_ptr trace;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      const auto& t = std::get<0>(p);
+      if( t->scheduled ) { trace = t; }
+   } );
+
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   BOOST_REQUIRE( bool(trace) );
+   BOOST_REQUIRE_EQUAL( 1, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+   BOOST_REQUIRE_EQUAL( 0, row_size() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( migrate_old_approvals, eosio_msig_tester ) try {
+   set_code( N(eosio.msig), contracts::util::msig_wasm_old() );
+   set_abi( N(eosio.msig), contracts::util::msig_abi_old().data() );
+   produce_blocks();
+
+   //propose and approve with old version of eosio.msig
+   auto trx = reqauth("alice", {permission_level{N(alice), config::active_name}}, abi_serializer_max_time );
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+   );
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "second")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+   );
+
+   set_code( N(eosio.msig), contracts::msig_wasm() );
+   set_abi( N(eosio.msig), contracts::msig_abi().data() );
+   produce_blocks();
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(migrate), mvo()
+                                          ("proposer", "alice")
+                                          ("max_rows", 1)
+                            ),
+                            missing_auth_exception,
+                            fc_exception_message_starts_with("missing authority")
+   );
+
+   //only the first legacy row is migrated
+   push_action( N(eosio.msig), N(migrate), mvo()
+                  ("proposer", "alice")
+                  ("max_rows", 1)
+   );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(approvals), N(first) ).empty() );
+   BOOST_REQUIRE( !get_row_by_account( N(eosio.msig), N(alice), N(approvals2), N(first) ).empty() );
+   BOOST_REQUIRE( !get_row_by_account( N(eosio.msig), N(alice), N(approvals), N(second) ).empty() );
+
+   push_action( N(eosio.msig), N(setmigrated), mvo()
+                  ("migrated", true)
+   );
+
+   //legacy table is not probed anymore
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(approve), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "second")
+                                          ("level",         permission_level{ N(alice), config::active_name })
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("proposal not found")
+   );
+
+   //a later call picks up the remaining rows
+   push_action( N(eosio.msig), N(migrate), mvo()
+                  ("proposer", "alice")
+                  ("max_rows", 10)
+   );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(approvals), N(second) ).empty() );
+
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "second")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+
+   transaction_trace_ptr trace;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      const auto& t = std::get<0>(p);
+      if( t->scheduled ) { trace = t; }
+   } );
+
+   //approval given with the old version survives the migration
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   BOOST_REQUIRE( bool(trace) );
+   BOOST_REQUIRE_EQUAL( 1, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( sweep_expired_proposals, eosio_msig_tester ) try {
+   auto trx = reqauth("alice", {permission_level{N(alice), config::active_name}}, abi_serializer_max_time );
+
+   for ( auto prop : { N(first), N(second), N(third) } ) {
+      push_action( N(alice), N(propose), mvo()
+                     ("proposer",      "alice")
+                     ("proposal_name", prop)
+                     ("trx",           trx)
+                     ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+      );
+   }
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(carol), N(sweep), mvo()
+                                          ("max", 10)
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("no expired proposals to sweep")
+   );
+
+   //cancel removes the expiration entry along with the proposal
+   push_action( N(alice), N(cancel), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "third")
+                  ("canceler",      "alice")
+   );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(eosio.msig), N(expiry), 2 ).empty() );
+
+   //let the proposed transaction expire
+   produce_block( fc::hours(1) );
+   produce_blocks();
+
+   //anyone may sweep, oldest expiration first
+   push_action( N(carol), N(sweep), mvo()
+                  ("max", 1)
+   );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(proposal), N(first) ).empty() );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(approvals2), N(first) ).empty() );
+   BOOST_REQUIRE( !get_row_by_account( N(eosio.msig), N(alice), N(proposal), N(second) ).empty() );
+
+   push_action( N(carol), N(sweep), mvo()
+                  ("max", 10)
+   );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(proposal), N(second) ).empty() );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(alice), N(approvals2), N(second) ).empty() );
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(eosio.msig), N(expiry), 1 ).empty() );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(exec), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("executer",      "alice")
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("proposal not found")
+   );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( proposal_stores_transaction_hash, eosio_msig_tester ) try {
+   auto trx = reqauth("alice", {permission_level{N(alice), config::active_name}}, abi_serializer_max_time );
+   auto trx_hash = fc::sha256::hash( trx );
+
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+   );
+
+   //the proposal row keeps the transaction readable next to its checksum
+   auto prop = abi_ser.binary_to_variant( "proposal",
+                                          get_row_by_account( N(eosio.msig), N(alice), N(proposal), N(first) ),
+                                          abi_serializer_max_time );
+   BOOST_REQUIRE( fc::raw::pack( trx ) == prop["packed_transaction"].as<bytes>() );
+   BOOST_REQUIRE_EQUAL( trx_hash, prop["trx_hash"].as<fc::sha256>() );
+
+   //approve by digest and execute
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+                  ("proposal_hash", trx_hash)
+   );
+
+   transaction_trace_ptr trace;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      const auto& t = std::get<0>(p);
+      if( t->scheduled ) { trace = t; }
+   } );
+
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   BOOST_REQUIRE( bool(trace) );
+   BOOST_REQUIRE_EQUAL( 1, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( invalidation_epoch, eosio_msig_tester ) try {
+   auto trx = reqauth("alice", vector<permission_level>{ { N(alice), config::active_name }, { N(bob), config::active_name } }, abi_serializer_max_time );
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{ { N(alice), config::active_name }, { N(bob), config::active_name } })
+   );
+
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+
+   //no invalidation recorded yet
+   BOOST_REQUIRE( get_row_by_account( N(eosio.msig), N(eosio.msig), N(global), N(global) ).empty() );
+
+   //invalidation by an unrelated account moves the epoch past alice's approval
+   push_action( N(carol), N(invalidate), mvo()
+                  ("account",      "carol")
+   );
+   auto global = abi_ser.binary_to_variant( "msig_global_state",
+                                            get_row_by_account( N(eosio.msig), N(eosio.msig), N(global), N(global) ),
+                                            abi_serializer_max_time );
+   BOOST_REQUIRE( global.get_object().contains( "last_invalidation_time" ) );
+   BOOST_REQUIRE_EQUAL( false, global["legacy_approvals_migrated"].as_bool() );
+   produce_block();
+
+   //bob approves after the epoch, alice's earlier approval is still looked up and valid
+   push_action( N(bob), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(bob), config::active_name })
+   );
+
+   transaction_trace_ptr trace;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      const auto& t = std::get<0>(p);
+      if( t->scheduled ) { trace = t; }
+   } );
+
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   BOOST_REQUIRE( bool(trace) );
+   BOOST_REQUIRE_EQUAL( 1, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( exec_seeds_invalidation_epoch, eosio_msig_tester ) try {
+   //invalidated before any exec, the invals row stays authoritative for older approvals
+   push_action( N(alice), N(invalidate), mvo()
+                  ("account",      "alice")
+   );
+   produce_block();
+
+   auto trx = reqauth("alice", {permission_level{N(alice), config::active_name}}, abi_serializer_max_time );
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested", vector<permission_level>{{ N(alice), config::active_name }})
+   );
+   push_action( N(alice), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(alice), config::active_name })
+   );
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   auto global = abi_ser.binary_to_variant( "msig_global_state",
+                                            get_row_by_account( N(eosio.msig), N(eosio.msig), N(global), N(global) ),
+                                            abi_serializer_max_time );
+   BOOST_REQUIRE( global.get_object().contains( "last_invalidation_time" ) );
+   BOOST_REQUIRE( control->pending_block_time() >= global["last_invalidation_time"].as<fc::time_point>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(eosio_msig_benchmarks)
+
+BOOST_FIXTURE_TEST_CASE( approvals_benchmark, eosio_msig_tester ) try {
+   // Reports the apply time of the approval actions on a proposal with many requested approvals.
+   // To compare allocators or other builds, pass one, it is run against the same state:
+   //    unit_test --run_test=eosio_msig_benchmarks/approvals_benchmark -- --reference-msig-wasm=<path>
+   vector<account_name> approvers;
+   for( char c = 'a'; c <= 'p'; ++c ) {
+      approvers.emplace_back( std::string("approver") + c );
+   }
+   create_accounts( approvers );
+   produce_block();
+
+   vector<permission_level> requested;
+   for( const auto& a : approvers ) {
+      requested.push_back( { a, config::active_name } );
+   }
+   requested.push_back( { N(alice), config::active_name } );
+   std::sort( requested.begin(), requested.end() );
+   auto trx = reqauth( "alice", { permission_level{ N(alice), config::active_name } }, abi_serializer_max_time );
+
+   auto elapsed = []( const transaction_trace_ptr& trace ) {
+      return trace->action_traces.front().elapsed.count();
+   };
+
+   const uint32_t rounds = 5;
+   auto measure = [&]() {
+      std::vector<std::pair<std::string, double>> us = { { "propose", 0 }, { "approve", 0 }, { "unapprove", 0 }, { "cancel", 0 } };
+      for( uint32_t r = 0; r < rounds; ++r ) {
+         us[0].second += double( elapsed( push_action( N(alice), N(propose), mvo()
+                                                          ("proposer",      "alice")
+                                                          ("proposal_name", "bench")
+                                                          ("trx",           trx)
+                                                          ("requested",     requested) ) ) ) / rounds;
+         us[1].second += double( elapsed( push_action( N(alice), N(approve), mvo()
+                                                          ("proposer",      "alice")
+                                                          ("proposal_name", "bench")
+                                                          ("level",         permission_level{ N(alice), config::active_name }) ) ) ) / rounds;
+         us[2].second += double( elapsed( push_action( N(alice), N(unapprove), mvo()
+                                                          ("proposer",      "alice")
+                                                          ("proposal_name", "bench")
+                                                          ("level",         permission_level{ N(alice), config::active_name }) ) ) ) / rounds;
+         us[3].second += double( elapsed( push_action( N(alice), N(cancel), mvo()
+                                                          ("proposer",      "alice")
+                                                          ("proposal_name", "bench")
+                                                          ("canceler",      "alice") ) ) ) / rounds;
+      }
+      return us;
+   };
+
+   const auto current = measure();
+
+   const auto reference_wasm = contracts::util::reference_wasm( "msig" );
+   if( reference_wasm.empty() ) {
+      for( const auto& [action, us] : current ) {
+         BOOST_TEST_MESSAGE( action << ": " << us << " us" );
+      }
+      return;
+   }
+
+   set_code( N(eosio.msig), reference_wasm );
+   produce_block();
+   const auto reference = measure();
+   for( size_t i = 0; i < current.size(); ++i ) {
+      BOOST_TEST_MESSAGE( current[i].first << ": " << current[i].second << " us, reference " << reference[i].second
+                          << " us, saved " << reference[i].second - current[i].second << " us" );
+   }
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
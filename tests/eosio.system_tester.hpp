@@ -831,6 +831,11 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "eosio_global_state", data, abi_serializer_max_time );
    }
 
+   fc::variant get_global_hot_state() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(globalhot), N(globalhot) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "eosio_global_hot_state", data, abi_serializer_max_time );
+   }
+
    fc::variant get_global_state2() {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(global2), N(global2) );
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "eosio_global_state2", data, abi_serializer_max_time );
@@ -100,6 +100,20 @@ public:
       );
    }
 
+   action_result transfers( account_name from,
+                            const vector<mvo>& payments ) {
+      return push_action( from, N(transfers), mvo()
+           ( "from", from)
+           ( "payments", payments)
+      );
+   }
+
+   fc::variant get_checkpoint( account_name acc, uint64_t id )
+   {
+      vector<char> data = get_row_by_account( N(eosio.token), acc, N(checkpoints), id );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "checkpoint", data, abi_serializer_max_time );
+   }
+
    action_result open( account_name owner,
                        const string& symbolname,
                        account_name ram_payer    ) {
@@ -243,6 +257,61 @@ BOOST_FIXTURE_TEST_CASE( issue_tests, eosio_token_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( issuemany_tests, eosio_token_tester ) try {
+
+   create( N(alice), asset::from_string("1000.000 TKN"));
+   produce_blocks(1);
+
+   BOOST_REQUIRE_EQUAL( success(),
+      push_action( N(alice), N(issuemany), mvo()
+         ( "payments", vector<mvo>{
+            mvo()("to", "bob")("quantity", "300.000 TKN")("memo", "one"),
+            mvo()("to", "carol")("quantity", "200.000 TKN")("memo", "two")
+         } )
+      )
+   );
+
+   auto stats = get_stats("3,TKN");
+   REQUIRE_MATCHING_OBJECT( stats, mvo()
+      ("supply", "500.000 TKN")
+      ("max_supply", "1000.000 TKN")
+      ("issuer", "alice")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(bob), "3,TKN"), mvo()
+      ("balance", "300.000 TKN")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(carol), "3,TKN"), mvo()
+      ("balance", "200.000 TKN")
+   );
+   BOOST_REQUIRE( get_account(N(alice), "3,TKN").is_null() );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "quantity exceeds available supply" ),
+      push_action( N(alice), N(issuemany), mvo()
+         ( "payments", vector<mvo>{
+            mvo()("to", "bob")("quantity", "300.000 TKN")("memo", ""),
+            mvo()("to", "carol")("quantity", "200.001 TKN")("memo", "")
+         } )
+      )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "must issue positive quantity" ),
+      push_action( N(alice), N(issuemany), mvo()
+         ( "payments", vector<mvo>{
+            mvo()("to", "bob")("quantity", "0.000 TKN")("memo", "")
+         } )
+      )
+   );
+
+   BOOST_REQUIRE_EQUAL( error( "missing authority of alice" ),
+      push_action( N(bob), N(issuemany), mvo()
+         ( "payments", vector<mvo>{
+            mvo()("to", "bob")("quantity", "1.000 TKN")("memo", "")
+         } )
+      )
+   );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( retire_tests, eosio_token_tester ) try {
 
    auto token = create( N(alice), asset::from_string("1000.000 TKN"));
@@ -346,6 +415,169 @@ BOOST_FIXTURE_TEST_CASE( transfer_tests, eosio_token_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( transfers_tests, eosio_token_tester ) try {
+
+   create( N(alice), asset::from_string("1000 CERO"));
+   create( N(alice), asset::from_string("1000 TWO"));
+   issue( N(alice), asset::from_string("1000 CERO"), "hola" );
+   issue( N(alice), asset::from_string("1000 TWO"), "hola" );
+   produce_blocks(1);
+
+   BOOST_REQUIRE_EQUAL( success(),
+      transfers( N(alice), {
+         mvo()("to", "bob")("quantity", "300 CERO")("memo", "one"),
+         mvo()("to", "carol")("quantity", "200 CERO")("memo", "two"),
+         mvo()("to", "bob")("quantity", "50 CERO")("memo", "three")
+      } )
+   );
+
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "450 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(bob), "0,CERO"), mvo()
+      ("balance", "350 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(carol), "0,CERO"), mvo()
+      ("balance", "200 CERO")
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "no payments to transfer" ),
+      transfers( N(alice), {} )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "overdrawn balance" ),
+      transfers( N(alice), {
+         mvo()("to", "bob")("quantity", "400 CERO")("memo", ""),
+         mvo()("to", "carol")("quantity", "51 CERO")("memo", "")
+      } )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "cannot transfer to self" ),
+      transfers( N(alice), {
+         mvo()("to", "bob")("quantity", "1 CERO")("memo", ""),
+         mvo()("to", "alice")("quantity", "1 CERO")("memo", "")
+      } )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "must transfer positive quantity" ),
+      transfers( N(alice), {
+         mvo()("to", "bob")("quantity", "1 CERO")("memo", ""),
+         mvo()("to", "carol")("quantity", "-1 CERO")("memo", "")
+      } )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "symbol precision mismatch" ),
+      transfers( N(alice), {
+         mvo()("to", "bob")("quantity", "1 CERO")("memo", ""),
+         mvo()("to", "carol")("quantity", "1 TWO")("memo", "")
+      } )
+   );
+
+   // nothing was moved by the failed actions
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "450 CERO")
+   );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( checkpoint_tests, eosio_token_tester ) try {
+
+   create( N(alice), asset::from_string("1000 CERO"));
+   issue( N(alice), asset::from_string("1000 CERO"), "" );
+   produce_blocks(1);
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "checkpoints not enabled" ),
+      push_action( N(alice), N(newepoch), mvo()( "sym", "CERO" ) )
+   );
+   BOOST_REQUIRE_EQUAL( error( "missing authority of alice" ),
+      push_action( N(bob), N(enableckpt), mvo()( "sym", "CERO" ) )
+   );
+
+   // balances changed before enabling are not recorded
+   transfer( N(alice), N(carol), asset::from_string("100 CERO"), "" );
+   BOOST_REQUIRE( get_checkpoint( N(alice), 0 ).is_null() );
+
+   BOOST_REQUIRE_EQUAL( success(), push_action( N(alice), N(enableckpt), mvo()( "sym", "CERO" ) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "checkpoints already enabled" ),
+      push_action( N(alice), N(enableckpt), mvo()( "sym", "CERO" ) )
+   );
+
+   // epoch 0: only the first change of each balance is recorded
+   transfer( N(alice), N(bob), asset::from_string("100 CERO"), "" );
+   produce_blocks(1);
+   transfer( N(alice), N(bob), asset::from_string("100 CERO"), "" );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(alice), 0 ), mvo()
+      ("id", 0)
+      ("epoch", 0)
+      ("balance", "900 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(bob), 0 ), mvo()
+      ("id", 0)
+      ("epoch", 0)
+      ("balance", "0 CERO")
+   );
+   BOOST_REQUIRE( get_checkpoint( N(alice), 1 ).is_null() );
+   BOOST_REQUIRE( get_checkpoint( N(bob), 1 ).is_null() );
+
+   // epoch 1 records the balances as of the end of epoch 0
+   BOOST_REQUIRE_EQUAL( success(), push_action( N(alice), N(newepoch), mvo()( "sym", "CERO" ) ) );
+   transfer( N(bob), N(alice), asset::from_string("50 CERO"), "" );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(alice), 1 ), mvo()
+      ("id", 1)
+      ("epoch", 1)
+      ("balance", "700 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(bob), 1 ), mvo()
+      ("id", 1)
+      ("epoch", 1)
+      ("balance", "200 CERO")
+   );
+
+   // carol's balance did not change since enabling
+   BOOST_REQUIRE( get_checkpoint( N(carol), 0 ).is_null() );
+
+   // the epoch lives in the token statistics
+   BOOST_REQUIRE_EQUAL( 1, get_stats( "0,CERO" )["checkpoint_epoch"].as_uint64() );
+
+   // bob's checkpoints are billed to alice, the sender, until bob authorizes a change himself
+   const auto& rlm = control->get_resource_limits_manager();
+   BOOST_REQUIRE_EQUAL( success(), push_action( N(alice), N(newepoch), mvo()( "sym", "CERO" ) ) );
+   auto alice_ram_usage = rlm.get_account_ram_usage( N(alice) );
+   auto bob_ram_usage = rlm.get_account_ram_usage( N(bob) );
+   transfer( N(alice), N(bob), asset::from_string("1 CERO"), "" );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(bob), 2 ), mvo()
+      ("id", 2)
+      ("epoch", 2)
+      ("balance", "150 CERO")
+   );
+   BOOST_REQUIRE( rlm.get_account_ram_usage( N(alice) ) > alice_ram_usage );
+   BOOST_REQUIRE_EQUAL( bob_ram_usage, rlm.get_account_ram_usage( N(bob) ) );
+
+   // checkpoints older than the retention window are pruned when the next one is written
+   for( uint32_t epoch = 3; epoch <= 32; ++epoch ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( N(alice), N(newepoch), mvo()( "sym", "CERO" ) ) );
+      transfer( N(alice), N(bob), asset::from_string("1 CERO"), "" );
+   }
+   BOOST_REQUIRE( get_checkpoint( N(alice), 0 ).is_null() );
+   BOOST_REQUIRE( get_checkpoint( N(bob), 0 ).is_null() );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(bob), 1 ), mvo()
+      ("id", 1)
+      ("epoch", 1)
+      ("balance", "200 CERO")
+   );
+
+   // epoch 33 only needs the checkpoints from epoch 2 on
+   BOOST_REQUIRE_EQUAL( success(), push_action( N(alice), N(newepoch), mvo()( "sym", "CERO" ) ) );
+   transfer( N(alice), N(bob), asset::from_string("1 CERO"), "" );
+   BOOST_REQUIRE( get_checkpoint( N(bob), 1 ).is_null() );
+   REQUIRE_MATCHING_OBJECT( get_checkpoint( N(bob), 2 ), mvo()
+      ("id", 2)
+      ("epoch", 2)
+      ("balance", "150 CERO")
+   );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( open_tests, eosio_token_tester ) try {
 
    auto token = create( N(alice), asset::from_string("1000 CERO"));
@@ -420,3 +652,67 @@ BOOST_FIXTURE_TEST_CASE( close_tests, eosio_token_tester ) try {
 } FC_LOG_AND_RETHROW()
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(eosio_token_benchmarks)
+
+BOOST_FIXTURE_TEST_CASE( transfers_benchmark, eosio_token_tester ) try {
+   // create accounts {payeea, ..., payeez, payeeza, ..., payeezx}
+   vector<account_name> recipients;
+   {
+      const std::string root("payee");
+      for ( char c = 'a'; c <= 'z'; ++c ) {
+         recipients.emplace_back(root + std::string(1, c));
+      }
+      for ( char c = 'a'; c <= 'x'; ++c ) {
+         recipients.emplace_back(root + "z" + std::string(1, c));
+      }
+   }
+   const size_t payment_count = recipients.size();
+   create_accounts( recipients );
+
+   create( N(alice), asset::from_string("1000000 CERO"));
+   issue( N(alice), asset::from_string("1000000 CERO"), "" );
+   // both runs credit existing balances
+   for( const auto& r : recipients ) {
+      transfer( N(alice), r, asset::from_string("1 CERO"), "" );
+   }
+   produce_blocks(1);
+
+   auto run = [&]( vector<action>&& actions ) {
+      signed_transaction trx;
+      trx.actions = std::move( actions );
+      set_transaction_headers( trx );
+      trx.sign( get_private_key( N(alice), "active" ), control->get_chain_id() );
+      auto trace = push_transaction( trx );
+      produce_blocks(1);
+      return trace->elapsed.count();
+   };
+
+   vector<action> individual;
+   for( const auto& r : recipients ) {
+      individual.emplace_back( get_action( N(eosio.token), N(transfer), {{N(alice), config::active_name}}, mvo()
+         ("from", "alice")("to", r)("quantity", "1 CERO")("memo", "payroll") ) );
+   }
+   auto individual_us = run( std::move(individual) );
+
+   vector<mvo> payments;
+   for( const auto& r : recipients ) {
+      payments.push_back( mvo()("to", r)("quantity", "1 CERO")("memo", "payroll") );
+   }
+   vector<action> batched;
+   batched.emplace_back( get_action( N(eosio.token), N(transfers), {{N(alice), config::active_name}}, mvo()
+      ("from", "alice")("payments", payments) ) );
+   auto batched_us = run( std::move(batched) );
+
+   BOOST_TEST_MESSAGE( "transfer:  " << double(individual_us) / payment_count << " us per payment" );
+   BOOST_TEST_MESSAGE( "transfers: " << double(batched_us) / payment_count << " us per payment" );
+
+   for( const auto& r : recipients ) {
+      REQUIRE_MATCHING_OBJECT( get_account(r, "0,CERO"), mvo()
+         ("balance", "3 CERO")
+      );
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -109,14 +109,15 @@ public:
       );
    }
 
-   transaction wrap_exec( account_name executer, const transaction& trx, uint32_t expiration = base_tester::DEFAULT_EXPIRATION_DELTA );
+   transaction wrap_exec( account_name executer, const transaction& trx, uint32_t expiration = base_tester::DEFAULT_EXPIRATION_DELTA,
+                          action_name act_name = N(exec) );
 
    transaction reqauth( account_name from, const vector<permission_level>& auths, uint32_t expiration = base_tester::DEFAULT_EXPIRATION_DELTA );
 
    abi_serializer abi_ser;
 };
 
-transaction eosio_wrap_tester::wrap_exec( account_name executer, const transaction& trx, uint32_t expiration ) {
+transaction eosio_wrap_tester::wrap_exec( account_name executer, const transaction& trx, uint32_t expiration, action_name act_name ) {
    fc::variants v;
    v.push_back( fc::mutable_variant_object()
                   ("actor", executer)
@@ -128,7 +129,7 @@ transaction eosio_wrap_tester::wrap_exec( account_name executer, const transacti
              );
    auto act_obj = fc::mutable_variant_object()
                      ("account", "eosio.wrap")
-                     ("name", "exec")
+                     ("name", act_name)
                      ("authorization", v)
                      ("data", fc::mutable_variant_object()("executer", executer)("trx", trx) );
    transaction trx2;
@@ -200,6 +201,45 @@ BOOST_FIXTURE_TEST_CASE( wrap_exec_direct, eosio_wrap_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( wrap_execinline_direct, eosio_wrap_tester ) try {
+   auto trx = reqauth( N(bob), {permission_level{N(bob), config::active_name}} );
+
+   bool scheduled = false;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      if( std::get<0>(p)->scheduled ) { scheduled = true; }
+   } );
+
+   signed_transaction wrap_trx( wrap_exec( N(alice), trx, base_tester::DEFAULT_EXPIRATION_DELTA, N(execinline) ), {}, {} );
+   wrap_trx.sign( get_private_key( N(alice), "active" ), control->get_chain_id() );
+   for( const auto& actor : {"prod1", "prod2", "prod3", "prod4"} ) {
+      wrap_trx.sign( get_private_key( actor, "active" ), control->get_chain_id() );
+   }
+   auto trace = push_transaction( wrap_trx );
+
+   produce_block();
+
+   //the wrapped action is part of the wrapping transaction
+   BOOST_REQUIRE( !scheduled );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+   BOOST_REQUIRE_EQUAL( 2, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( "eosio", name{trace->action_traces[1].act.account} );
+   BOOST_REQUIRE_EQUAL( "reqauth", name{trace->action_traces[1].act.name} );
+
+   //delayed transactions are not dispatched inline
+   trx.delay_sec = 10;
+   signed_transaction delayed_trx( wrap_exec( N(alice), trx, base_tester::DEFAULT_EXPIRATION_DELTA, N(execinline) ), {}, {} );
+   delayed_trx.sign( get_private_key( N(alice), "active" ), control->get_chain_id() );
+   for( const auto& actor : {"prod1", "prod2", "prod3", "prod4"} ) {
+      delayed_trx.sign( get_private_key( actor, "active" ), control->get_chain_id() );
+   }
+   BOOST_REQUIRE_EXCEPTION( push_transaction( delayed_trx ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("inline execution requires a transaction without delay")
+   );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( wrap_with_msig, eosio_wrap_tester ) try {
    auto trx = reqauth( N(bob), {permission_level{N(bob), config::active_name}} );
    auto wrap_trx = wrap_exec( N(alice), trx );
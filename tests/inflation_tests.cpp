@@ -0,0 +1,57 @@
+#include <boost/test/unit_test.hpp>
+
+#include <eosio.system/inflation.hpp>
+
+#include <cmath>
+#include <random>
+
+using eosiosystem::inflation_for_period;
+
+namespace {
+   constexpr int64_t  useconds_per_year = int64_t(52 * 7 * 24 * 3600) * 1000'000ll;
+   constexpr int64_t  useconds_per_day  = int64_t(24 * 3600) * 1000'000ll;
+   constexpr uint32_t numerator         = 5'827'323;
+   constexpr uint32_t denominator       = 100'000'000;
+   constexpr double   continuous_rate   = 0.05827323;
+
+   /// the floating point formula onblock used before
+   int64_t double_inflation( int64_t supply, int64_t usecs ) {
+      return static_cast<int64_t>( (continuous_rate * double(supply) * double(usecs)) / double(useconds_per_year) );
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(inflation_tests)
+
+BOOST_AUTO_TEST_CASE( matches_double_formula ) {
+   // supplies from 1 thousand to 100 billion tokens with 4 decimals, distributions one day apart give or take a few hours
+   std::mt19937_64 rng( 20191017 );
+   std::uniform_int_distribution<int64_t> supplies( 1'000'0000ll, 100'000'000'000'0000ll );
+   std::uniform_int_distribution<int64_t> periods( useconds_per_day, useconds_per_day + 6 * 3600 * 1000'000ll );
+
+   for( int i = 0; i < 100000; ++i ) {
+      const auto supply = supplies( rng );
+      const auto usecs  = periods( rng );
+      const auto fixed  = inflation_for_period( supply, usecs, numerator, denominator, useconds_per_year );
+      const auto floating = double_inflation( supply, usecs );
+      BOOST_REQUIRE_MESSAGE( std::abs( fixed - floating ) <= 1,
+                             "supply " << supply << " over " << usecs << " us: " << fixed << " vs " << floating );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( exact_values ) {
+   // one year at the default rate
+   BOOST_REQUIRE_EQUAL( 5'827'323, inflation_for_period( 100'000'000, useconds_per_year, numerator, denominator, useconds_per_year ) );
+   // rounded down
+   BOOST_REQUIRE_EQUAL( 0, inflation_for_period( 1, useconds_per_day, numerator, denominator, useconds_per_year ) );
+   BOOST_REQUIRE_EQUAL( 0, inflation_for_period( 0, useconds_per_day, numerator, denominator, useconds_per_year ) );
+   BOOST_REQUIRE_EQUAL( 0, inflation_for_period( 100'000'000, 0, numerator, denominator, useconds_per_year ) );
+   // a changed rate applies proportionally
+   BOOST_REQUIRE_EQUAL( 10'000'000, inflation_for_period( 100'000'000, useconds_per_year, 1, 10, useconds_per_year ) );
+}
+
+BOOST_AUTO_TEST_CASE( overflow ) {
+   BOOST_REQUIRE_EQUAL( -1, inflation_for_period( INT64_MAX, INT64_MAX, UINT32_MAX - 1, UINT32_MAX, useconds_per_year ) );
+   BOOST_REQUIRE_EQUAL( -1, inflation_for_period( INT64_MAX, 10 * useconds_per_year, 1, 2, useconds_per_year ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
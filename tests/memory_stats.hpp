@@ -0,0 +1,36 @@
+#pragma once
+
+#include <eosio/chain/trace.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+
+/**
+ * Heap use reported by contracts built with CONTRACTS_MEMORY_STATS,
+ * see contracts/common/include/memory_stats.hpp.
+ */
+struct action_memory_stats {
+   eosio::chain::account_name receiver;
+   eosio::chain::action_name  action;
+   uint64_t                   allocations = 0;
+   uint64_t                   peak_bytes  = 0;
+   uint64_t                   pages       = 0;
+};
+
+/// Stats of every action in `trace` that reported them, in execution order; empty if the contracts were built without them
+inline std::vector<action_memory_stats> get_memory_stats( const eosio::chain::transaction_trace_ptr& trace ) {
+   std::vector<action_memory_stats> stats;
+   for( const auto& at : trace->action_traces ) {
+      const auto pos = at.console.rfind( "memstats " );
+      if( pos == std::string::npos ) continue;
+
+      action_memory_stats s;
+      s.receiver = at.receiver;
+      s.action   = at.act.name;
+      if( sscanf( at.console.c_str() + pos, "memstats allocations=%" SCNu64 " peak_bytes=%" SCNu64 " pages=%" SCNu64,
+                  &s.allocations, &s.peak_bytes, &s.pages ) == 3 ) {
+         stats.push_back( s );
+      }
+   }
+   return stats;
+}
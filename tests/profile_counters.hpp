@@ -0,0 +1,51 @@
+#pragma once
+
+#include <eosio/chain/trace.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+/**
+ * Section counters reported by an eosio.system built with WORBLI_PROFILE,
+ * see contracts/eosio.system/include/eosio.system/profile.hpp.
+ */
+struct profile_counters {
+   uint32_t calls   = 0;
+   uint32_t reads   = 0;
+   uint32_t writes  = 0;
+   uint32_t inlines = 0;
+};
+
+struct action_profile {
+   eosio::chain::account_name              receiver;
+   eosio::chain::action_name               action;
+   std::map<std::string, profile_counters> sections;
+};
+
+/// Counters of every action in `trace` that reported them, in execution order; empty for builds without profiling
+inline std::vector<action_profile> get_profile_counters( const eosio::chain::transaction_trace_ptr& trace ) {
+   std::vector<action_profile> profiles;
+   for( const auto& at : trace->action_traces ) {
+      action_profile p;
+      p.receiver = at.receiver;
+      p.action   = at.act.name;
+
+      std::istringstream console( at.console );
+      std::string line;
+      while( std::getline( console, line ) ) {
+         if( line.compare( 0, 8, "profile " ) != 0 ) continue;
+         const auto counters = line.rfind( " calls=" );
+         if( counters == std::string::npos ) continue;
+
+         profile_counters c;
+         if( sscanf( line.c_str() + counters, " calls=%" SCNu32 " reads=%" SCNu32 " writes=%" SCNu32 " inlines=%" SCNu32,
+                     &c.calls, &c.reads, &c.writes, &c.inlines ) == 4 ) {
+            p.sections[ line.substr( 8, counters - 8 ) ] = c;
+         }
+      }
+      if( !p.sections.empty() ) profiles.push_back( std::move(p) );
+   }
+   return profiles;
+}
@@ -0,0 +1,159 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/testing/tester.hpp>
+
+#include <IR/Module.h>
+#include <Inline/Serialization.h>
+#include <Runtime/Runtime.h>
+#include <WASM/WASM.h>
+
+#include <fc/io/json.hpp>
+#include <fc/variant_object.hpp>
+
+#include "contracts.hpp"
+
+using namespace eosio::testing;
+using namespace eosio;
+using namespace eosio::chain;
+using namespace fc;
+
+using mvo = fc::mutable_variant_object;
+
+/**
+ * Size report for every contract built under contracts/.
+ *
+ * Run it with `make wasm_size_report` from the tests build directory, ctest does not. Sizes are compared
+ * against wasm_baseline.json, growth beyond `tolerance_percent` fails the test, and so does a
+ * contract without a baseline entry. After an intended change, refresh the baseline with
+ *    unit_test --run_test=wasm_size_benchmarks -- --update-wasm-baseline
+ * The apply times of the first two actions sent to each contract are machine dependent and only
+ * reported. The first one includes compiling and instantiating the module, it is not a measurement
+ * of instantiation alone.
+ */
+struct wasm_stats {
+   uint64_t wasm_bytes       = 0;
+   uint64_t function_exports = 0;
+   uint64_t data_bytes       = 0;
+};
+
+static wasm_stats get_wasm_stats( const std::vector<uint8_t>& code ) {
+   IR::Module module;
+   Serialization::MemoryInputStream stream( code.data(), code.size() );
+   WASM::serialize( stream, module );
+
+   wasm_stats stats;
+   stats.wasm_bytes = code.size();
+   for( const auto& e : module.exports ) {
+      if( e.kind == IR::ObjectKind::function ) ++stats.function_exports;
+   }
+   for( const auto& seg : module.dataSegments ) {
+      stats.data_bytes += seg.data.size();
+   }
+   return stats;
+}
+
+static bool update_baseline_requested() {
+   const auto& suite = boost::unit_test::framework::master_test_suite();
+   for( int i = 0; i < suite.argc; ++i ) {
+      if( std::string("--update-wasm-baseline") == suite.argv[i] ) return true;
+   }
+   return false;
+}
+
+class wasm_size_tester : public tester {
+public:
+
+   /// Sets `code` on `account` and returns the wall time of the first and the second transaction
+   /// applied to it, in us. The pushed action does not exist, so the contract rejects it right away.
+   std::pair<int64_t, int64_t> time_first_applies( const name& account, const std::vector<uint8_t>& code ) {
+      create_accounts( { account } );
+      set_code( account, code );
+      produce_blocks(1);
+
+      auto apply = [&]( uint32_t nonce ) {
+         signed_transaction trx;
+         action act;
+         act.account       = account;
+         act.name          = N(nop);
+         act.authorization = vector<permission_level>{ { account, config::active_name } };
+         act.data          = fc::raw::pack( nonce );
+         trx.actions.emplace_back( std::move(act) );
+         set_transaction_headers( trx );
+         trx.sign( get_private_key( account, "active" ), control->get_chain_id() );
+
+         auto start = fc::time_point::now();
+         try {
+            push_transaction( trx );
+         } catch( const fc::exception& ) {
+            // contracts reject unknown actions after the module has been instantiated
+         }
+         return (fc::time_point::now() - start).count();
+      };
+
+      auto first  = apply(0);
+      auto second = apply(1);
+      produce_blocks(1);
+      return { first, second };
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(wasm_size_benchmarks)
+
+BOOST_FIXTURE_TEST_CASE( wasm_size_report, wasm_size_tester ) try {
+   const std::vector<std::tuple<std::string, name, std::vector<uint8_t>>> artifacts = {
+      { "eosio.bios",     N(size.bios),   contracts::bios_wasm() },
+      { "eosio.msig",     N(size.msig),   contracts::msig_wasm() },
+      { "eosio.system",   N(size.system), contracts::system_wasm() },
+      { "rex.results",    N(size.rex),    contracts::rex_results_wasm() },
+      { "eosio.token",    N(size.token),  contracts::token_wasm() },
+      { "eosio.wrap",     N(size.wrap),   contracts::wrap_wasm() },
+      { "worblitimelock", N(size.lock),   contracts::worblitimelock_wasm() }
+   };
+
+   const auto baseline_path = contracts::util::wasm_baseline_path();
+   const auto baseline      = fc::json::from_file( baseline_path ).get_object();
+   const auto tolerance     = baseline["tolerance_percent"].as_uint64();
+   const auto& expected     = baseline["contracts"].get_object();
+
+   mvo measured;
+   for( const auto& [contract, account, code] : artifacts ) {
+      const auto stats = get_wasm_stats( code );
+      const auto times = time_first_applies( account, code );
+
+      BOOST_TEST_MESSAGE( contract << ": " << stats.wasm_bytes << " bytes, "
+                          << stats.function_exports << " exported functions, "
+                          << stats.data_bytes << " data bytes, "
+                          << times.first << " us first apply, " << times.second << " us second apply" );
+
+      measured( contract, mvo()
+         ("wasm_bytes", stats.wasm_bytes)
+         ("function_exports", stats.function_exports)
+         ("data_bytes", stats.data_bytes)
+      );
+
+      auto itr = expected.find( contract );
+      if( itr == expected.end() ) {
+         BOOST_CHECK_MESSAGE( update_baseline_requested(), contract << " has no baseline in " << baseline_path
+                                                           << ", record it with --update-wasm-baseline" );
+         continue;
+      }
+      const auto& base = itr->value().get_object();
+      const std::vector<std::pair<std::string, uint64_t>> fields = {
+         { "wasm_bytes",       stats.wasm_bytes },
+         { "function_exports", stats.function_exports },
+         { "data_bytes",       stats.data_bytes }
+      };
+      for( const auto& [field, actual] : fields ) {
+         const auto limit = base[field].as_uint64() * (100 + tolerance) / 100;
+         BOOST_CHECK_MESSAGE( actual <= limit, contract << " " << field << " grew to " << actual
+                                               << ", baseline allows " << limit );
+      }
+   }
+
+   if( update_baseline_requested() ) {
+      fc::json::save_to_file( mvo()("tolerance_percent", tolerance)("contracts", measured), baseline_path, true );
+      BOOST_TEST_MESSAGE( "baseline written to " << baseline_path );
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,8 @@
 #include <eosio/testing/tester.hpp>
 #include <eosio/chain/abi_serializer.hpp>
 #include "eosio.system_tester.hpp"
+#include "memory_stats.hpp"
+#include "profile_counters.hpp"
 
 #include "Runtime/Runtime.h"
 
@@ -128,6 +130,42 @@ public:
          return base_tester::push_action( std::move(act), uint64_t(signer) );
    }
 
+   // pushes a system action and returns the data of the result action it reports to eosio.rex
+   bytes get_system_action_result( const account_name& signer, const action_name& name, const variant_object& data,
+                                   const action_name& result ) {
+      auto trace = base_tester::push_action( config::system_account_name, name, signer, data );
+      for ( const auto& at : trace->action_traces ) {
+         if ( at.act.account == N(eosio.rex) && at.act.name == result ) {
+            return at.act.data;
+         }
+      }
+      return bytes();
+   }
+
+   // produces blocks past the refund delay and returns the trace of the deferred refund that ran
+   transaction_trace_ptr run_deferred_refund() {
+      transaction_trace_ptr refund;
+      auto c = control->applied_transaction.connect(
+         [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+            const auto& t = std::get<0>(p);
+            if( t->scheduled && !t->action_traces.empty() && t->action_traces.front().act.name == N(refund) ) {
+               refund = t;
+            }
+         } );
+      produce_block( fc::days(3) );
+      produce_block();
+      c.disconnect();
+      BOOST_REQUIRE( bool(refund) );
+      return refund;
+   }
+
+   // pushes a system action in its own block and returns the time spent applying it, in us
+   int64_t time_system_action( const account_name& signer, const action_name& name, const variant_object& data ) {
+      auto trace = base_tester::push_action( config::system_account_name, name, signer, data );
+      produce_blocks( 1 );
+      return trace->action_traces.front().elapsed.count();
+   }
+
    action_result push_token_action( const account_name& signer, const action_name &name, const variant_object &data ) {
       string action_type_name = token_abi_ser.get_action_type(name);
 
@@ -181,6 +219,11 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "eosio_global_state", data, abi_serializer_max_time );
    }
 
+   fc::variant get_global_hot_state() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(globalhot), N(globalhot) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "eosio_global_hot_state", data, abi_serializer_max_time );
+   }
+
    fc::variant get_worbli_params() {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(worbliglobal), N(worbliglobal) );
       if (data.empty()) std::cout << "\nData is empty\n" << std::endl;
@@ -193,6 +236,25 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "exchange_state", data, abi_serializer_max_time );
    }
 
+   fc::variant get_producer_uptime() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(produptime), N(produptime) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "producer_uptime", data, abi_serializer_max_time );
+   }
+
+   fc::variant get_uptime_counters() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(uptimectr), N(uptimectr) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "producer_uptime_counters", data, abi_serializer_max_time );
+   }
+
+   // requires a row to decode with the generic abi serializer and to pack back to the same bytes
+   void check_generic_layout( const account_name& scope, const name& table, const account_name& key, const string& type ) {
+      vector<char> data = get_row_by_account( config::system_account_name, scope, table, key );
+      BOOST_REQUIRE( !data.empty() );
+      auto repacked = abi_ser.variant_to_binary( type, abi_ser.binary_to_variant( type, data, abi_serializer_max_time ),
+                                                 abi_serializer_max_time );
+      BOOST_REQUIRE( repacked == data );
+   }
+
    fc::variant get_producer_info( const account_name& act ) {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(producers), act );
       return abi_ser.binary_to_variant( "producer_info", data, abi_serializer_max_time );
@@ -539,6 +601,150 @@ BOOST_FIXTURE_TEST_CASE( delegate_ram_tests, worbli_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( ram_result_tests, worbli_system_tester ) try {
+      issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+      create_free_account_with_resources(N(test1), N(worbli.admin));
+
+      name owner;
+      int64_t bytes = 0;
+      asset tokens, total_ram_refund, stake;
+
+      // buyrambytes reports the bytes bought and the tokens staked for them
+      auto result = get_system_action_result( N(worbli.admin), N(buyrambytes), mvo()
+                                                ("payer", "worbli.admin")("receiver", "test1")("bytes", 1000),
+                                              N(ramresult) );
+      BOOST_REQUIRE( !result.empty() );
+      {
+         fc::datastream<const char*> ds( result.data(), result.size() );
+         fc::raw::unpack( ds, owner );
+         fc::raw::unpack( ds, bytes );
+         fc::raw::unpack( ds, tokens );
+         fc::raw::unpack( ds, total_ram_refund );
+      }
+      BOOST_REQUIRE_EQUAL( name(N(test1)), owner );
+      BOOST_REQUIRE_EQUAL( get_total_stake(N(test1))["ram_bytes"].as_int64() - 8000, bytes );
+      BOOST_REQUIRE( tokens.get_amount() > 0 );
+      BOOST_REQUIRE_EQUAL( 0, total_ram_refund.get_amount() );
+      produce_blocks( 1 );
+
+      // sellram reports the bytes sold and the refund scheduled
+      result = get_system_action_result( N(test1), N(sellram), mvo()("account", "test1")("bytes", 100), N(ramresult) );
+      BOOST_REQUIRE( !result.empty() );
+      {
+         fc::datastream<const char*> ds( result.data(), result.size() );
+         fc::raw::unpack( ds, owner );
+         fc::raw::unpack( ds, bytes );
+         fc::raw::unpack( ds, tokens );
+         fc::raw::unpack( ds, total_ram_refund );
+      }
+      BOOST_REQUIRE_EQUAL( name(N(test1)), owner );
+      BOOST_REQUIRE_EQUAL( -100, bytes );
+      BOOST_REQUIRE( tokens.get_amount() > 0 );
+      BOOST_REQUIRE_EQUAL( tokens, total_ram_refund );
+      produce_blocks( 1 );
+
+      // a sale while a refund is pending reports its own tokens and the accumulated refund
+      const asset first_sale = tokens;
+      result = get_system_action_result( N(test1), N(sellram), mvo()("account", "test1")("bytes", 100), N(ramresult) );
+      BOOST_REQUIRE( !result.empty() );
+      {
+         fc::datastream<const char*> ds( result.data(), result.size() );
+         fc::raw::unpack( ds, owner );
+         fc::raw::unpack( ds, bytes );
+         fc::raw::unpack( ds, tokens );
+         fc::raw::unpack( ds, total_ram_refund );
+      }
+      BOOST_REQUIRE_EQUAL( -100, bytes );
+      BOOST_REQUIRE( tokens.get_amount() > 0 );
+      BOOST_REQUIRE_EQUAL( first_sale + tokens, total_ram_refund );
+      const auto request = abi_ser.binary_to_variant( "refund_request",
+                                                      get_row_by_account( config::system_account_name, N(test1), N(refunds), N(test1) ),
+                                                      abi_serializer_max_time );
+      BOOST_REQUIRE_EQUAL( total_ram_refund, request["ram_amount"].as<asset>() );
+      produce_blocks( 1 );
+
+      // delegateram reports the delegated bytes and stake
+      name from, receiver;
+      result = get_system_action_result( N(eosio), N(delegateram), mvo()("from", "eosio")("receiver", "test1")("bytes", 8000),
+                                         N(delramresult) );
+      BOOST_REQUIRE( !result.empty() );
+      {
+         fc::datastream<const char*> ds( result.data(), result.size() );
+         fc::raw::unpack( ds, from );
+         fc::raw::unpack( ds, receiver );
+         fc::raw::unpack( ds, bytes );
+         fc::raw::unpack( ds, stake );
+      }
+      BOOST_REQUIRE_EQUAL( name(N(eosio)), from );
+      BOOST_REQUIRE_EQUAL( name(N(test1)), receiver );
+      BOOST_REQUIRE_EQUAL( 8000, bytes );
+      BOOST_REQUIRE_EQUAL( get_delegated_ram( N(eosio), N(test1) )["ram_stake"].as<asset>(), stake );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( global_hot_state_tests, worbli_system_tester ) try {
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+
+   const auto params   = get_global_state();
+   const auto reserved = get_global_hot_state()["total_ram_bytes_reserved"].as<uint64_t>();
+
+   // ram purchases only update the hot state, the parameter block is not rewritten
+   BOOST_REQUIRE_EQUAL( success(), buyram( N(worbli.admin), N(test1), 1000 ) );
+   const auto hot = get_global_hot_state();
+   BOOST_REQUIRE( reserved < hot["total_ram_bytes_reserved"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( params["total_ram_bytes_reserved"].as<uint64_t>(),
+                        get_global_state()["total_ram_bytes_reserved"].as<uint64_t>() );
+
+   // writing the parameter block mirrors the hot fields into it
+   BOOST_REQUIRE_EQUAL( success(), push_system_action( N(eosio), N(setparams), mvo()("params", params) ) );
+   BOOST_REQUIRE_EQUAL( hot["total_ram_bytes_reserved"].as<uint64_t>(),
+                        get_global_state()["total_ram_bytes_reserved"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( hot["total_ram_stake"].as<int64_t>(), get_global_state()["total_ram_stake"].as<int64_t>() );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( fixed_layout_rows_tests, worbli_system_tester ) try {
+   // rows written by the hand-written serializers match the layout of the generic one
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+   create_accounts_with_resources( { N(producer1) }, N(worbli.admin) );
+   transfer(N(worbli.admin), N(test1), asset(10000000, symbol(4,"TST")), "");
+
+   BOOST_REQUIRE_EQUAL( success(), push_system_action( N(test1), N(delegatebw), mvo()
+      ("from", "test1")("receiver", "test1")("stake_net_quantity", "3.0000 TST")("stake_cpu_quantity", "4.0000 TST")("transfer", false) ) );
+   BOOST_REQUIRE_EQUAL( success(), push_system_action( N(test1), N(undelegatebw), mvo()
+      ("from", "test1")("receiver", "test1")("unstake_net_quantity", "1.0000 TST")("unstake_cpu_quantity", "2.0000 TST") ) );
+   BOOST_REQUIRE_EQUAL( success(), delegateram( N(eosio), N(test1), 8000 ) );
+   BOOST_REQUIRE_EQUAL( success(), addprod( N(producer1) ) );
+   BOOST_REQUIRE_EQUAL( success(), promoteprod( N(producer1) ) );
+   BOOST_REQUIRE_EQUAL( success(), regprod( N(producer1) ) );
+
+   check_generic_layout( N(test1), N(userres), N(test1), "user_resources" );
+   check_generic_layout( N(test1), N(delband), N(test1), "delegated_bandwidth" );
+   check_generic_layout( N(test1), N(refunds), N(test1), "refund_request" );
+   check_generic_layout( N(eosio), N(delram), N(test1), "delegated_ram" );
+   check_generic_layout( config::system_account_name, N(producers), N(producer1), "producer_info" );
+
+   // rows read back by the hand-written serializers carry the values written
+   REQUIRE_MATCHING_OBJECT( get_total_stake(N(test1)), mvo()
+      ("owner", "test1")
+      ("net_weight", "12.0000 TST")
+      ("cpu_weight", "12.0000 TST")
+      ("ram_stake", "470.5882 TST")
+      ("ram_bytes", "16000")
+   );
+   const auto refund = get_row_by_account( config::system_account_name, N(test1), N(refunds), N(test1) );
+   const auto request = abi_ser.binary_to_variant( "refund_request", refund, abi_serializer_max_time );
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("1.0000"), request["net_amount"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("2.0000"), request["cpu_amount"].as<asset>() );
+   const auto producer = get_producer_info( N(producer1) );
+   BOOST_REQUIRE_EQUAL( "http://example.com", producer["url"].as_string() );
+   BOOST_REQUIRE_EQUAL( 844, producer["location"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( get_public_key( N(producer1), "active" ), producer["producer_key"].as<public_key_type>() );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( test_new_account, worbli_system_tester ) try {
 
    // setup WTP framework
@@ -628,6 +834,16 @@ BOOST_FIXTURE_TEST_CASE( producer_tests, worbli_system_tester ) try {
    // produce blocks for 12 rounds
    produce_blocks( 12 * 5 * 12 );
 
+   // production is only marked in the global state until the daily roll-up
+   BOOST_REQUIRE_EQUAL( 0x1f, get_global_hot_state()["produced_blocks"].as<uint64_t>() );
+   for( auto p : producers ) {
+      auto info = get_producer_info(p);
+      BOOST_REQUIRE_EQUAL( 0, info["unpaid_blocks"].as<uint32_t>() );
+   }
+
+   produce_block( fc::days(1) );
+   produce_blocks( 1 );
+
    for( auto p : producers ) {
       auto info = get_producer_info(p);
       BOOST_REQUIRE_EQUAL( 1, info["unpaid_blocks"].as<uint32_t>() );
@@ -655,6 +871,8 @@ BOOST_FIXTURE_TEST_CASE( producer_tests, worbli_system_tester ) try {
    BOOST_REQUIRE_EQUAL( success(), regprod(N(producer1)));
 
    produce_blocks( 12 * 5 * 12 );
+   produce_block( fc::days(1) );
+   produce_blocks( 1 );
 
    {
       auto info = get_producer_info(N(producer11));
@@ -672,4 +890,303 @@ BOOST_FIXTURE_TEST_CASE( producer_tests, worbli_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( setinflation_tests, worbli_system_tester ) try {
+   BOOST_REQUIRE_EQUAL( error("missing authority of worbli.admin"),
+                        push_system_action( N(eosio), N(setinflation), mvo()("numerator", 1)("denominator", 20) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("denominator must be positive"),
+                        push_system_action( N(worbli.admin), N(setinflation), mvo()("numerator", 0)("denominator", 0) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("inflation rate must be below 100%"),
+                        push_system_action( N(worbli.admin), N(setinflation), mvo()("numerator", 20)("denominator", 20) ) );
+
+   BOOST_REQUIRE_EQUAL( success(),
+                        push_system_action( N(worbli.admin), N(setinflation), mvo()("numerator", 1)("denominator", 20) ) );
+   produce_blocks(1);
+
+   auto params = get_worbli_params();
+   BOOST_REQUIRE_EQUAL( 1, params["inflation_numerator"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 20, params["inflation_denominator"].as<uint32_t>() );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( producer_uptime_tests, worbli_system_tester ) try {
+   vector<account_name> producers = {  N(producer1), N(producer2), N(producer3) };
+
+   create_accounts_with_resources( producers, N(worbli.admin) );
+   for( auto p : producers ) {
+      BOOST_REQUIRE_EQUAL( success(), addprod(p));
+      BOOST_REQUIRE_EQUAL( success(), promoteprod(p));
+      BOOST_REQUIRE_EQUAL( success(), regprod(p));
+   }
+   BOOST_REQUIRE_EQUAL( success(), activate());
+
+   // produce blocks for 12 rounds
+   produce_blocks( 12 * 3 * 12 );
+
+   // the blocks of the current day are counted in uptimectr, the row is written at day and schedule changes
+   auto uptime = get_producer_uptime();
+   auto entries = uptime["producers"].get_array();
+   auto counters = get_uptime_counters();
+   auto counts = counters["blocks"].as<vector<uint32_t>>();
+   auto last_produced = counters["last_produced"].as<vector<block_timestamp_type>>();
+   BOOST_REQUIRE_EQUAL( producers.size(), entries.size() );
+   BOOST_REQUIRE_EQUAL( producers.size(), counts.size() );
+   BOOST_REQUIRE_EQUAL( uptime["day"].as<uint32_t>(), counters["day"].as<uint32_t>() );
+   vector<uint32_t> blocks;
+   for( size_t i = 0; i < producers.size(); ++i ) {
+      BOOST_REQUIRE_EQUAL( producers[i], entries[i]["producer"].as<account_name>() );
+      BOOST_REQUIRE( 0 < counts[i] );
+      BOOST_REQUIRE_EQUAL( 0, entries[i]["blocks_previous_day"].as<uint32_t>() );
+      BOOST_REQUIRE( block_timestamp_type() < last_produced[i] );
+      blocks.push_back( entries[i]["blocks_current_day"].as<uint32_t>() + counts[i] );
+   }
+
+   // the counters of the current day move to the previous day
+   produce_block( fc::days(1) );
+   produce_blocks( 1 );
+
+   uptime = get_producer_uptime();
+   entries = uptime["producers"].get_array();
+   counts = get_uptime_counters()["blocks"].as<vector<uint32_t>>();
+   BOOST_REQUIRE_EQUAL( producers.size(), entries.size() );
+   uint32_t produced_today = 0;
+   for( size_t i = 0; i < producers.size(); ++i ) {
+      BOOST_REQUIRE_EQUAL( blocks[i], entries[i]["blocks_previous_day"].as<uint32_t>() );
+      BOOST_REQUIRE( block_timestamp_type() < entries[i]["last_produced"].as<block_timestamp_type>() );
+      BOOST_REQUIRE_EQUAL( 0, entries[i]["blocks_current_day"].as<uint32_t>() );
+      produced_today += counts[i];
+   }
+   BOOST_REQUIRE_EQUAL( 2, produced_today );
+
+   // producers leaving the schedule drop out, the others keep their counters
+   BOOST_REQUIRE_EQUAL( success(), unregprod(N(producer2)));
+   produce_blocks( 12 * 3 * 12 );
+
+   uptime = get_producer_uptime();
+   entries = uptime["producers"].get_array();
+   BOOST_REQUIRE_EQUAL( size_t(2), entries.size() );
+   BOOST_REQUIRE_EQUAL( N(producer1), entries[0]["producer"].as<account_name>() );
+   BOOST_REQUIRE_EQUAL( blocks[0], entries[0]["blocks_previous_day"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( N(producer3), entries[1]["producer"].as<account_name>() );
+   BOOST_REQUIRE_EQUAL( blocks[2], entries[1]["blocks_previous_day"].as<uint32_t>() );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( memory_stats_format, worbli_system_tester ) try {
+   // the line printed by contract_memory::report(), after other output of the action
+   auto trace = std::make_shared<transaction_trace>();
+   trace->action_traces.emplace_back();
+   trace->action_traces.back().receiver = config::system_account_name;
+   trace->action_traces.back().act.name = N(delegatebw);
+   trace->action_traces.back().console  = "staked\nmemstats allocations=12 peak_bytes=3456 pages=2\n";
+   trace->action_traces.emplace_back();
+   trace->action_traces.back().console  = "no stats";
+
+   const auto parsed = get_memory_stats( trace );
+   BOOST_REQUIRE_EQUAL( size_t(1), parsed.size() );
+   BOOST_REQUIRE_EQUAL( config::system_account_name, parsed[0].receiver );
+   BOOST_REQUIRE_EQUAL( N(delegatebw), parsed[0].action );
+   BOOST_REQUIRE_EQUAL( 12, parsed[0].allocations );
+   BOOST_REQUIRE_EQUAL( 3456, parsed[0].peak_bytes );
+   BOOST_REQUIRE_EQUAL( 2, parsed[0].pages );
+
+   // whatever the contracts were built with, a reported line parses
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+   transfer(N(worbli.admin), N(test1), asset(10000000, symbol(4,"TST")), "");
+   auto delegated = base_tester::push_action( config::system_account_name, N(delegatebw), N(test1), mvo()
+      ("from", "test1")("receiver", "test1")("stake_net_quantity", "1.0000 TST")("stake_cpu_quantity", "1.0000 TST")("transfer", false) );
+   const bool reported = std::any_of( delegated->action_traces.begin(), delegated->action_traces.end(),
+                                      []( const auto& at ) { return at.console.find( "memstats " ) != std::string::npos; } );
+   const auto stats = get_memory_stats( delegated );
+   BOOST_REQUIRE_EQUAL( reported, !stats.empty() );
+   for( const auto& s : stats ) {
+      BOOST_REQUIRE( 0 < s.pages );
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( profile_format, worbli_system_tester ) try {
+   // the lines printed by eosiosystem::profile::report(), section names may contain spaces
+   auto trace = std::make_shared<transaction_trace>();
+   trace->action_traces.emplace_back();
+   trace->action_traces.back().receiver = config::system_account_name;
+   trace->action_traces.back().act.name = N(onblock);
+   trace->action_traces.back().console  = "profile onblock calls=1 reads=4 writes=2 inlines=0\n"
+                                          "profile producer pay calls=1 reads=3 writes=1 inlines=2\n";
+   trace->action_traces.emplace_back();
+   trace->action_traces.back().console  = "profile without counters\n";
+
+   const auto parsed = get_profile_counters( trace );
+   BOOST_REQUIRE_EQUAL( size_t(1), parsed.size() );
+   BOOST_REQUIRE_EQUAL( N(onblock), parsed[0].action );
+   BOOST_REQUIRE_EQUAL( size_t(2), parsed[0].sections.size() );
+   const auto& onblock = parsed[0].sections.at( "onblock" );
+   BOOST_REQUIRE_EQUAL( 1, onblock.calls );
+   BOOST_REQUIRE_EQUAL( 4, onblock.reads );
+   BOOST_REQUIRE_EQUAL( 2, onblock.writes );
+   BOOST_REQUIRE_EQUAL( 0, onblock.inlines );
+   const auto& pay = parsed[0].sections.at( "producer pay" );
+   BOOST_REQUIRE_EQUAL( 3, pay.reads );
+   BOOST_REQUIRE_EQUAL( 1, pay.writes );
+   BOOST_REQUIRE_EQUAL( 2, pay.inlines );
+
+   // whatever eosio.system was built with, reported lines parse
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+   transfer(N(worbli.admin), N(test1), asset(10000000, symbol(4,"TST")), "");
+   auto delegated = base_tester::push_action( config::system_account_name, N(delegatebw), N(test1), mvo()
+      ("from", "test1")("receiver", "test1")("stake_net_quantity", "1.0000 TST")("stake_cpu_quantity", "1.0000 TST")("transfer", false) );
+   const bool reported = std::any_of( delegated->action_traces.begin(), delegated->action_traces.end(),
+                                      []( const auto& at ) { return at.console.find( "profile " ) != std::string::npos; } );
+   BOOST_REQUIRE_EQUAL( reported, !get_profile_counters( delegated ).empty() );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(worbli_system_benchmarks)
+
+BOOST_FIXTURE_TEST_CASE( dispatch_benchmark, worbli_system_tester ) try {
+   // Reports the apply time of a representative action per dispatch entry. To see what a change saves,
+   // pass another build of the system contract, it is run against the same state:
+   //    unit_test --run_test=worbli_system_benchmarks/dispatch_benchmark -- --reference-system-wasm=<path>
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+   transfer(N(worbli.admin), N(test1), asset(10000000, symbol(4,"TST")), "");
+   produce_blocks( 1 );
+
+   const auto net = core_sym::from_string("1.0000");
+   const auto cpu = core_sym::from_string("1.0000");
+   const std::vector<std::pair<std::string, std::function<int64_t()>>> steps = {
+      { "updateauth", [&]() {
+         return time_system_action( N(test1), N(updateauth), mvo()
+            ("account", "test1")("permission", "bench")("parent", "active")
+            ("auth", authority( get_public_key( N(test1), "bench" ) )) );
+      } },
+      { "delegatebw", [&]() {
+         return time_system_action( N(test1), N(delegatebw), mvo()
+            ("from", "test1")("receiver", "test1")("stake_net_quantity", net)("stake_cpu_quantity", cpu)("transfer", false) );
+      } },
+      { "undelegatebw", [&]() {
+         return time_system_action( N(test1), N(undelegatebw), mvo()
+            ("from", "test1")("receiver", "test1")("unstake_net_quantity", net)("unstake_cpu_quantity", cpu) );
+      } },
+      { "refund", [&]() {
+         return run_deferred_refund()->action_traces.front().elapsed.count();
+      } },
+      { "buyrambytes", [&]() {
+         return time_system_action( N(worbli.admin), N(buyrambytes), mvo()
+            ("payer", "worbli.admin")("receiver", "test1")("bytes", 1000) );
+      } },
+      { "sellram", [&]() {
+         return time_system_action( N(test1), N(sellram), mvo()("account", "test1")("bytes", 1000) );
+      } },
+      { "delegateram", [&]() {
+         return time_system_action( N(eosio), N(delegateram), mvo()("from", "eosio")("receiver", "test1")("bytes", 100) );
+      } },
+      { "setwparams", [&]() {
+         return time_system_action( N(worbli.admin), N(setwparams), mvo()("max_subaccounts", 10) );
+      } }
+   };
+
+   const uint32_t rounds = 5;
+   auto measure = [&]() {
+      std::vector<double> us( steps.size() );
+      for( uint32_t r = 0; r < rounds; ++r ) {
+         for( size_t i = 0; i < steps.size(); ++i ) {
+            us[i] += double( steps[i].second() ) / rounds;
+         }
+      }
+      return us;
+   };
+
+   const auto current = measure();
+
+   const auto reference_wasm = contracts::util::reference_wasm( "system" );
+   if( reference_wasm.empty() ) {
+      for( size_t i = 0; i < steps.size(); ++i ) {
+         BOOST_TEST_MESSAGE( steps[i].first << ": " << current[i] << " us" );
+      }
+      return;
+   }
+
+   set_code( config::system_account_name, reference_wasm );
+   produce_blocks( 1 );
+   const auto reference = measure();
+   for( size_t i = 0; i < steps.size(); ++i ) {
+      BOOST_TEST_MESSAGE( steps[i].first << ": " << current[i] << " us, reference " << reference[i]
+                          << " us, saved " << reference[i] - current[i] << " us" );
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( memory_stats_report, worbli_system_tester ) try {
+   // Reports heap use per action. Contracts only record it when built with -DCONTRACTS_MEMORY_STATS=ON.
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+   create_accounts_with_resources( { N(producer1) }, N(worbli.admin) );
+   transfer(N(worbli.admin), N(test1), asset(10000000, symbol(4,"TST")), "");
+   BOOST_REQUIRE_EQUAL( success(), addprod( N(producer1) ) );
+   BOOST_REQUIRE_EQUAL( success(), promoteprod( N(producer1) ) );
+   produce_blocks( 1 );
+
+   const std::vector<std::tuple<account_name, action_name, mvo>> actions = {
+      { N(test1), N(delegatebw), mvo()("from", "test1")("receiver", "test1")
+                                      ("stake_net_quantity", "1.0000 TST")("stake_cpu_quantity", "1.0000 TST")("transfer", false) },
+      { N(worbli.admin), N(buyrambytes), mvo()("payer", "worbli.admin")("receiver", "test1")("bytes", 1000) },
+      { N(test1), N(sellram), mvo()("account", "test1")("bytes", 1000) },
+      { N(eosio), N(delegateram), mvo()("from", "eosio")("receiver", "test1")("bytes", 100) },
+      { N(producer1), N(regproducer), mvo()("producer", "producer1")("producer_key", get_public_key( N(producer1), "active" ))
+                                           ("url", "http://example.com")("location", 844) }
+   };
+
+   for( const auto& [signer, action, data] : actions ) {
+      auto trace = base_tester::push_action( config::system_account_name, action, signer, data );
+      produce_blocks( 1 );
+
+      const auto stats = get_memory_stats( trace );
+      BOOST_REQUIRE_MESSAGE( !stats.empty(), "contracts were built without CONTRACTS_MEMORY_STATS" );
+      for( const auto& s : stats ) {
+         BOOST_TEST_MESSAGE( name(s.receiver) << "::" << name(s.action) << ": " << s.allocations << " allocations, "
+                             << s.peak_bytes << " peak bytes, " << s.pages << " pages" );
+      }
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( profile_report, worbli_system_tester ) try {
+   // Reports eosio.system section counters per action. Only builds with -DWORBLI_PROFILE=ON record them.
+   issue(config::system_account_name, N(eosio), asset(10000000000000, symbol(4,"TST")), "" );
+   create_free_account_with_resources(N(test1), N(worbli.admin));
+   transfer(N(worbli.admin), N(test1), asset(10000000, symbol(4,"TST")), "");
+   produce_blocks( 1 );
+
+   auto report = [&]( const transaction_trace_ptr& trace ) {
+      const auto profiles = get_profile_counters( trace );
+      for( const auto& p : profiles ) {
+         for( const auto& [section, c] : p.sections ) {
+            BOOST_TEST_MESSAGE( name(p.receiver) << "::" << name(p.action) << " " << section << ": " << c.calls << " calls, "
+                                << c.reads << " reads, " << c.writes << " writes, " << c.inlines << " inlines" );
+         }
+      }
+      return !profiles.empty();
+   };
+
+   auto push = [&]( const account_name& signer, const action_name& action, const variant_object& data ) {
+      auto trace = base_tester::push_action( config::system_account_name, action, signer, data );
+      produce_blocks( 1 );
+      return trace;
+   };
+
+   BOOST_REQUIRE_MESSAGE( report( push( N(test1), N(delegatebw), mvo()("from", "test1")("receiver", "test1")
+                                        ("stake_net_quantity", "1.0000 TST")("stake_cpu_quantity", "1.0000 TST")("transfer", false) ) ),
+                          "eosio.system was built without WORBLI_PROFILE" );
+   report( push( N(test1), N(undelegatebw), mvo()("from", "test1")("receiver", "test1")
+                 ("unstake_net_quantity", "1.0000 TST")("unstake_cpu_quantity", "1.0000 TST") ) );
+   report( push( N(worbli.admin), N(buyrambytes), mvo()("payer", "worbli.admin")("receiver", "test1")("bytes", 1000) ) );
+   report( push( N(test1), N(sellram), mvo()("account", "test1")("bytes", 100) ) );
+   report( run_deferred_refund() );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
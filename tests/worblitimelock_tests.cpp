@@ -47,6 +47,7 @@ public:
       );
 
       link_authority( N(founders), N(eosio.token),  N(payout), "transfer" );
+      link_authority( N(founders), N(founders),     N(payout), "claimresult" );
 
    }
 
@@ -158,6 +159,21 @@ public:
       );
    }
 
+   asset get_claim_result( account_name owner ) {
+      auto trace = base_tester::push_action( N(founders), N(claim), owner, mvo()( "owner", owner ) );
+      asset released;
+      for ( const auto& at : trace->action_traces ) {
+         if ( at.act.name == N(claimresult) ) {
+            fc::datastream<const char*> ds( at.act.data.data(), at.act.data.size() );
+            name result_owner;
+            fc::raw::unpack( ds, result_owner );
+            fc::raw::unpack( ds, released );
+            BOOST_REQUIRE_EQUAL( owner, result_owner );
+         }
+      }
+      return released;
+   }
+
    fc::variant get_stats( const string& symbolname ) {
       auto symb = eosio::chain::symbol::from_string(symbolname);
       auto symbol_code = symb.to_symbol_code().value;
@@ -179,9 +195,9 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "recipient", data, abi_serializer_max_time );
    }
 
-   fc::variant get_variable( name var ) {
-      vector<char> data = get_row_by_account( N(founders), N(founders), N(variables), var );
-      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "variable", data, abi_serializer_max_time );
+   fc::variant get_escrow() {
+      vector<char> data = get_row_by_account( N(founders), N(founders), N(escrow), N(escrow) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "escrow_state", data, abi_serializer_max_time );
    }
 
    uint32_t last_block_time() const {
@@ -328,8 +344,16 @@ BOOST_FIXTURE_TEST_CASE( standard_claim_tests, worblitimelock_tester ) try {
    // produce 6 more months so we can claim tranche2
    produce_block( fc::days(185) );
 
-   BOOST_REQUIRE_EQUAL( success(), 
-                        claim( N(founder1) ) 
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("150.0000"), 
+                        get_claim_result( N(founder1) ) 
+   );
+
+   // only the contract itself reports claim results
+   BOOST_REQUIRE_EQUAL( error( "missing authority of founders" ),
+                        push_action( N(founder1), N(claimresult), mvo()
+                           ( "owner", "founder1" )
+                           ( "released", core_sym::from_string("1.0000") )
+                        )
    );
 
    // balance should be 450.0000 as tranche2 has been reached
@@ -387,10 +411,10 @@ BOOST_FIXTURE_TEST_CASE( existing_claim_tests, worblitimelock_tester ) try {
                         ) 
    );
 
-   auto liability = get_variable(N(liabilities));
-   REQUIRE_MATCHING_OBJECT( liability, mvo()
-      ("key", "liabilities")
-      ("val_int", 7000000)
+   auto escrow = get_escrow();
+   REQUIRE_MATCHING_OBJECT( escrow, mvo()
+      ("balance", "10000.0000 TST")
+      ("liabilities", 7000000)
    );
 
    BOOST_REQUIRE_EQUAL( success(), 
@@ -475,4 +499,65 @@ BOOST_FIXTURE_TEST_CASE( existing_claim_tests, worblitimelock_tester ) try {
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE( escrow_tracking_tests, worblitimelock_tester ) try {
+
+   // nothing is tracked until the contract is funded
+   BOOST_REQUIRE_EQUAL( true, get_escrow().is_null() );
+
+   transfer("eosio", "founders", core_sym::from_string("10000.0000"), "escrow funding");
+   REQUIRE_MATCHING_OBJECT( get_escrow(), mvo()
+      ("balance", "10000.0000 TST")
+      ("liabilities", 0)
+   );
+
+   transfer("eosio", "founders", core_sym::from_string("500.0000"), "escrow top up");
+   REQUIRE_MATCHING_OBJECT( get_escrow(), mvo()
+      ("balance", "10500.0000 TST")
+      ("liabilities", 0)
+   );
+
+   // issuemany notifies only with issuemany, never with transfer
+   base_tester::push_action( N(eosio.token), N(issuemany), config::system_account_name, mvo()
+      ("payments", vector<mvo>{ mvo()("to", "founders")("quantity", core_sym::from_string("250.0000"))("memo", "issued"),
+                                mvo()("to", "founder2")("quantity", core_sym::from_string("1.0000"))("memo", "") })
+   );
+   REQUIRE_MATCHING_OBJECT( get_escrow(), mvo()
+      ("balance", "10750.0000 TST")
+      ("liabilities", 0)
+   );
+   BOOST_REQUIRE_EQUAL( get_balance(N(founders)), get_escrow()["balance"].as<asset>() );
+
+   BOOST_REQUIRE_EQUAL( success(), set_condition( N(tranche1), 30000, "Tranche 1", "2020-05-15T00:00:00.000") );
+   BOOST_REQUIRE_EQUAL( success(), set_condition( N(tranche2), 70000, "Tranche 2", "2021-05-15T00:00:00.000") );
+
+   BOOST_REQUIRE_EQUAL( success(), 
+                        add_recipient( N(founder1), 
+                                       core_sym::from_string("1000.0000"), 
+                                       vector<name>{}
+                        ) 
+   );
+
+   REQUIRE_MATCHING_OBJECT( get_escrow(), mvo()
+      ("balance", "10750.0000 TST")
+      ("liabilities", 10000000)
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "insufficient funds on escrow account" ),
+                        update_recipient( N(founder1), core_sym::from_string("9750.0001") )
+   );
+
+   // payouts are reflected through the transfer notification
+   produce_block( fc::days(135) );
+   BOOST_REQUIRE_EQUAL( success(), claim( N(founder1) ) );
+
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("300.0000"), get_balance(N(founder1)) );
+   REQUIRE_MATCHING_OBJECT( get_escrow(), mvo()
+      ("balance", "10450.0000 TST")
+      ("liabilities", 7000000)
+   );
+   BOOST_REQUIRE_EQUAL( get_balance(N(founders)), get_escrow()["balance"].as<asset>() );
+
+} FC_LOG_AND_RETHROW()
+
+
 BOOST_AUTO_TEST_SUITE_END()